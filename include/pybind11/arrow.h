@@ -0,0 +1,742 @@
+/*
+    pybind11/arrow.h: Zero-copy exchange of columns through the Arrow C Data Interface
+
+    Copyright (c) 2025 The Pybind Development Team.
+
+    All rights reserved. Use of this source code is governed by a
+    BSD-style license that can be found in the LICENSE file.
+*/
+
+#pragma once
+
+#include "pybind11.h"
+
+#include <cerrno>
+#include <cstdint>
+#include <cstring>
+#include <exception>
+#include <memory>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+PYBIND11_NAMESPACE_BEGIN(PYBIND11_NAMESPACE)
+
+template <typename T>
+class arrow_array;
+class arrow_string_array;
+
+PYBIND11_NAMESPACE_BEGIN(detail)
+
+// The Arrow C Data and C Stream Interface structures
+// (https://arrow.apache.org/docs/format/CDataInterface.html), declared here so that pybind11
+// does not depend on Arrow. The names in comments are those of the specification.
+
+// ARROW_FLAG_NULLABLE
+constexpr std::int64_t arrow_flag_nullable = 2;
+
+// ArrowSchema, exchanged in capsules named "arrow_schema"
+struct arrow_c_schema {
+    const char *format;
+    const char *name;
+    const char *metadata;
+    std::int64_t flags;
+    std::int64_t n_children;
+    arrow_c_schema **children;
+    arrow_c_schema *dictionary;
+    void (*release)(arrow_c_schema *self);
+    void *private_data;
+};
+
+// ArrowArray, exchanged in capsules named "arrow_array"
+struct arrow_c_array {
+    std::int64_t length;
+    std::int64_t null_count;
+    std::int64_t offset;
+    std::int64_t n_buffers;
+    std::int64_t n_children;
+    const void **buffers;
+    arrow_c_array **children;
+    arrow_c_array *dictionary;
+    void (*release)(arrow_c_array *self);
+    void *private_data;
+};
+
+// ArrowArrayStream, exchanged in capsules named "arrow_array_stream"
+struct arrow_c_stream {
+    int (*get_schema)(arrow_c_stream *self, arrow_c_schema *out);
+    int (*get_next)(arrow_c_stream *self, arrow_c_array *out);
+    const char *(*get_last_error)(arrow_c_stream *self);
+    void (*release)(arrow_c_stream *self);
+    void *private_data;
+};
+
+// The Arrow format string of the element type T, if it has one.
+template <typename T, typename SFINAE = void>
+struct arrow_format {};
+
+template <typename T>
+struct arrow_format<T,
+                    enable_if_t<std::is_integral<T>::value && !std::is_same<T, bool>::value>> {
+    static const char *get() {
+        static const char *const codes[] = {"c", "C", "s", "S", "i", "I", "l", "L"};
+        size_t index = sizeof(T) == 1 ? 0 : sizeof(T) == 2 ? 2 : sizeof(T) == 4 ? 4 : 6;
+        return codes[index + (std::is_signed<T>::value ? 0 : 1)];
+    }
+};
+
+template <>
+struct arrow_format<float> {
+    static const char *get() { return "f"; }
+};
+
+template <>
+struct arrow_format<double> {
+    static const char *get() { return "g"; }
+};
+
+// An untyped Arrow array without children, as laid out by the C Data Interface. `owner` keeps
+// the buffers alive.
+struct arrow_view {
+    std::string format;
+    ssize_t length = 0;
+    ssize_t null_count = 0;
+    ssize_t offset = 0;
+    std::vector<const void *> buffers;
+    std::shared_ptr<void> owner;
+};
+
+inline bool arrow_bit(const std::uint8_t *bitmap, ssize_t index) {
+    return ((bitmap[index >> 3] >> (index & 7)) & 1) != 0;
+}
+
+inline ssize_t arrow_count_nulls(const std::uint8_t *validity, ssize_t offset, ssize_t length) {
+    ssize_t nulls = 0;
+    if (validity != nullptr) {
+        for (ssize_t i = offset; i < offset + length; ++i) {
+            nulls += arrow_bit(validity, i) ? 0 : 1;
+        }
+    }
+    return nulls;
+}
+
+// Moves the array out of `src`, which is left released, into a shared owner that releases it.
+inline std::shared_ptr<arrow_c_array> arrow_take(arrow_c_array &src) {
+    std::shared_ptr<arrow_c_array> array(new arrow_c_array(src), [](arrow_c_array *self) {
+        if (self->release != nullptr) {
+            self->release(self);
+        }
+        delete self;
+    });
+    src.release = nullptr;
+    return array;
+}
+
+// Views an imported array of a type without children nor dictionary.
+inline bool arrow_view_of(const char *format,
+                          const std::shared_ptr<arrow_c_array> &array,
+                          arrow_view &view) {
+    if (array->n_children != 0 || array->dictionary != nullptr) {
+        return false;
+    }
+    view.format = format;
+    view.length = static_cast<ssize_t>(array->length);
+    view.offset = static_cast<ssize_t>(array->offset);
+    view.buffers.assign(array->buffers, array->buffers + array->n_buffers);
+    view.null_count
+        = array->null_count >= 0
+              ? static_cast<ssize_t>(array->null_count)
+              : arrow_count_nulls(
+                    static_cast<const std::uint8_t *>(array->n_buffers > 0 ? view.buffers[0]
+                                                                           : nullptr),
+                    view.offset,
+                    view.length);
+    view.owner = array;
+    return true;
+}
+
+template <typename Capsule>
+Capsule *arrow_capsule_pointer(handle capsule, const char *name) {
+    if (PyCapsule_IsValid(capsule.ptr(), name) == 0) {
+        return nullptr;
+    }
+    return static_cast<Capsule *>(PyCapsule_GetPointer(capsule.ptr(), name));
+}
+
+// The format of `src.__arrow_c_schema__()`, or an empty string if `src` does not describe its
+// schema up front.
+inline std::string arrow_schema_format(handle src) {
+    if (!hasattr(src, "__arrow_c_schema__")) {
+        return std::string();
+    }
+    object capsule = src.attr("__arrow_c_schema__")();
+    auto *schema = arrow_capsule_pointer<arrow_c_schema>(capsule, "arrow_schema");
+    return schema != nullptr && schema->release != nullptr ? schema->format : "";
+}
+
+// Imports the array returned by `src.__arrow_c_array__()`, if its format is accepted by
+// `accepts`. Returns false if `src` does not support the protocol.
+template <typename Accepts>
+bool arrow_import_array(handle src, const Accepts &accepts, arrow_view &view) {
+    if (!hasattr(src, "__arrow_c_array__")) {
+        return false;
+    }
+    tuple capsules;
+    try {
+        capsules = reinterpret_borrow<tuple>(src.attr("__arrow_c_array__")());
+    } catch (const error_already_set &) {
+        return false;
+    }
+    if (!isinstance<tuple>(capsules) || capsules.size() != 2) {
+        return false;
+    }
+    auto *schema = arrow_capsule_pointer<arrow_c_schema>(capsules[0], "arrow_schema");
+    auto *array = arrow_capsule_pointer<arrow_c_array>(capsules[1], "arrow_array");
+    if (schema == nullptr || array == nullptr || schema->release == nullptr
+        || array->release == nullptr || !accepts(schema->format)) {
+        return false; // Left to the capsules to release.
+    }
+    return arrow_view_of(schema->format, arrow_take(*array), view);
+}
+
+// Imports all the arrays of the stream returned by `src.__arrow_c_stream__()`, if its format is
+// accepted by `accepts`. Returns false if `src` does not support the protocol.
+template <typename Accepts>
+bool arrow_import_stream(handle src, const Accepts &accepts, std::vector<arrow_view> &views) {
+    if (!hasattr(src, "__arrow_c_stream__")) {
+        return false;
+    }
+    object capsule;
+    try {
+        // Reading a stream may consume it: check the schema first, when it is available.
+        std::string format = arrow_schema_format(src);
+        if (!format.empty() && !accepts(format.c_str())) {
+            return false;
+        }
+        capsule = src.attr("__arrow_c_stream__")();
+    } catch (const error_already_set &) {
+        return false;
+    }
+    auto *stream = arrow_capsule_pointer<arrow_c_stream>(capsule, "arrow_array_stream");
+    if (stream == nullptr || stream->release == nullptr) {
+        return false;
+    }
+
+    auto fail = [stream](const char *what) {
+        const char *error = stream->get_last_error(stream);
+        throw value_error(std::string("Arrow stream: ") + what
+                          + (error != nullptr ? std::string(": ") + error : std::string()));
+    };
+    arrow_c_schema schema{};
+    if (stream->get_schema(stream, &schema) != 0) {
+        fail("could not get the schema");
+    }
+    std::shared_ptr<arrow_c_schema> schema_owner(&schema, [](arrow_c_schema *self) {
+        if (self->release != nullptr) {
+            self->release(self);
+        }
+    });
+    if (!accepts(schema.format)) {
+        return false;
+    }
+    while (true) {
+        arrow_c_array array{};
+        if (stream->get_next(stream, &array) != 0) {
+            fail("could not get the next array");
+        }
+        if (array.release == nullptr) {
+            return true; // End of the stream.
+        }
+        views.emplace_back();
+        if (!arrow_view_of(schema.format, arrow_take(array), views.back())) {
+            return false;
+        }
+    }
+}
+
+// Exports `view` into `out`, which shares the ownership of the buffers.
+inline void arrow_export_array(const arrow_view &view, arrow_c_array *out) {
+    struct context {
+        std::vector<const void *> buffers;
+        std::shared_ptr<void> owner;
+    };
+    auto *ctx = new context{view.buffers, view.owner};
+    out->length = view.length;
+    out->null_count = view.null_count;
+    out->offset = view.offset;
+    out->n_buffers = static_cast<std::int64_t>(ctx->buffers.size());
+    out->n_children = 0;
+    out->buffers = ctx->buffers.data();
+    out->children = nullptr;
+    out->dictionary = nullptr;
+    out->private_data = ctx;
+    out->release = [](arrow_c_array *self) {
+        delete static_cast<context *>(self->private_data);
+        self->release = nullptr;
+    };
+}
+
+inline void arrow_export_schema(const std::string &format, arrow_c_schema *out) {
+    auto *format_copy = new std::string(format);
+    out->format = format_copy->c_str();
+    out->name = nullptr;
+    out->metadata = nullptr;
+    out->flags = arrow_flag_nullable;
+    out->n_children = 0;
+    out->children = nullptr;
+    out->dictionary = nullptr;
+    out->private_data = format_copy;
+    out->release = [](arrow_c_schema *self) {
+        delete static_cast<std::string *>(self->private_data);
+        self->release = nullptr;
+    };
+}
+
+// Capsules releasing the structure they hold unless a consumer moved it out.
+template <typename Struct>
+capsule arrow_capsule(Struct *ptr, const char *name) {
+    std::unique_ptr<Struct> owned(ptr);
+    capsule result(ptr, name, [](void *p) {
+        auto *self = static_cast<Struct *>(p);
+        if (self->release != nullptr) {
+            self->release(self);
+        }
+        delete self;
+    });
+    owned.release();
+    return result;
+}
+
+inline capsule arrow_schema_capsule(const std::string &format) {
+    std::unique_ptr<arrow_c_schema> schema(new arrow_c_schema());
+    arrow_export_schema(format, schema.get());
+    return arrow_capsule(schema.release(), "arrow_schema");
+}
+
+// The Python objects returned for an `arrow_array` and an `arrow_chunked_array`, implementing
+// the Arrow PyCapsule Interface. `requested_schema` may be ignored by producers, and is.
+struct arrow_array_exporter {
+    arrow_view view;
+
+    object schema() const { return arrow_schema_capsule(view.format); }
+
+    object array(const object &) const {
+        std::unique_ptr<arrow_c_array> array(new arrow_c_array());
+        arrow_export_array(view, array.get());
+        return make_tuple(schema(), arrow_capsule(array.release(), "arrow_array"));
+    }
+};
+
+struct arrow_stream_exporter {
+    std::string format;
+    std::vector<arrow_view> chunks;
+
+    object schema() const { return arrow_schema_capsule(format); }
+
+    object stream(const object &) const {
+        std::unique_ptr<arrow_c_stream> stream(new arrow_c_stream());
+        stream->private_data = new context{format, chunks, 0, std::string()};
+        stream->get_schema = &get_schema;
+        stream->get_next = &get_next;
+        stream->get_last_error = &get_last_error;
+        stream->release = &release;
+        return arrow_capsule(stream.release(), "arrow_array_stream");
+    }
+
+    ssize_t size() const {
+        ssize_t size = 0;
+        for (const auto &chunk : chunks) {
+            size += chunk.length;
+        }
+        return size;
+    }
+
+private:
+    // The state of an exported stream, which may be read from any thread, without the GIL.
+    struct context {
+        std::string format;
+        std::vector<arrow_view> chunks;
+        size_t next;
+        std::string error;
+    };
+
+    static int fail(arrow_c_stream *self, const std::exception &e) {
+        auto *ctx = static_cast<context *>(self->private_data);
+        try {
+            ctx->error = e.what();
+        } catch (...) {
+            ctx->error.clear();
+        }
+        return ENOMEM;
+    }
+
+    static int get_schema(arrow_c_stream *self, arrow_c_schema *out) {
+        try {
+            arrow_export_schema(static_cast<context *>(self->private_data)->format, out);
+            return 0;
+        } catch (const std::exception &e) {
+            return fail(self, e);
+        }
+    }
+
+    static int get_next(arrow_c_stream *self, arrow_c_array *out) {
+        auto *ctx = static_cast<context *>(self->private_data);
+        if (ctx->next == ctx->chunks.size()) {
+            out->release = nullptr;
+            return 0;
+        }
+        try {
+            arrow_export_array(ctx->chunks[ctx->next], out);
+            ++ctx->next;
+            return 0;
+        } catch (const std::exception &e) {
+            return fail(self, e);
+        }
+    }
+
+    static const char *get_last_error(arrow_c_stream *self) {
+        auto *ctx = static_cast<context *>(self->private_data);
+        return ctx->error.empty() ? nullptr : ctx->error.c_str();
+    }
+
+    static void release(arrow_c_stream *self) {
+        delete static_cast<context *>(self->private_data);
+        self->release = nullptr;
+    }
+};
+
+inline object arrow_export(arrow_view view) {
+    if (!get_type_info(typeid(arrow_array_exporter), false)) {
+        class_<arrow_array_exporter>(handle(), "arrow_array", pybind11::module_local())
+            .def("__arrow_c_schema__", &arrow_array_exporter::schema)
+            .def("__arrow_c_array__",
+                 &arrow_array_exporter::array,
+                 arg("requested_schema") = none())
+            .def("__len__", [](const arrow_array_exporter &self) { return self.view.length; });
+    }
+    return cast(arrow_array_exporter{std::move(view)});
+}
+
+inline object arrow_export_stream(std::string format, std::vector<arrow_view> chunks) {
+    if (!get_type_info(typeid(arrow_stream_exporter), false)) {
+        class_<arrow_stream_exporter>(handle(), "arrow_chunked_array", pybind11::module_local())
+            .def("__arrow_c_schema__", &arrow_stream_exporter::schema)
+            .def("__arrow_c_stream__",
+                 &arrow_stream_exporter::stream,
+                 arg("requested_schema") = none())
+            .def("__len__", &arrow_stream_exporter::size);
+    }
+    return cast(arrow_stream_exporter{std::move(format), std::move(chunks)});
+}
+
+// Conversions between the typed arrays and `arrow_view`.
+template <typename Array>
+struct arrow_array_traits;
+
+PYBIND11_NAMESPACE_END(detail)
+
+/** \rst
+    A read-only view of an Arrow array of fixed-size numbers (``int8`` to ``uint64``,
+    ``float32`` and ``float64``), with an optional validity bitmap marking null elements.
+
+    As a function argument, any object implementing the Arrow PyCapsule Interface
+    (``__arrow_c_array__``) with elements of type ``T`` is accepted without copying, such as a
+    ``pyarrow.Array``. Returned to Python, an ``arrow_array`` becomes an object implementing
+    ``__arrow_c_array__``, which can be passed to ``pyarrow.array()``, ``polars.Series()``, etc.
+\endrst */
+template <typename T>
+class arrow_array {
+public:
+    arrow_array() = default;
+
+    /// Views ``size`` values at ``data``, kept alive by ``owner``. The element ``i`` is null if
+    /// the bit ``i`` of ``validity`` (least significant bit first) is 0.
+    arrow_array(const T *data,
+                ssize_t size,
+                std::shared_ptr<void> owner = nullptr,
+                const std::uint8_t *validity = nullptr)
+        : m_data(data), m_size(size), m_validity(validity),
+          m_null_count(detail::arrow_count_nulls(validity, 0, size)), m_owner(std::move(owner)) {}
+
+    /// Takes ownership of ``values``, none of which is null.
+    explicit arrow_array(std::vector<T> &&values) {
+        auto storage = std::make_shared<std::vector<T>>(std::move(values));
+        *this = arrow_array(storage->data(), static_cast<ssize_t>(storage->size()), storage);
+    }
+
+    const T *data() const { return m_data + m_offset; }
+    ssize_t size() const { return m_size; }
+    ssize_t null_count() const { return m_null_count; }
+    bool is_valid(ssize_t i) const {
+        return m_validity == nullptr || detail::arrow_bit(m_validity, m_offset + i);
+    }
+
+    /// The value of the element ``i``, which is unspecified if the element is null.
+    const T &operator[](ssize_t i) const { return m_data[m_offset + i]; }
+    const T *begin() const { return data(); }
+    const T *end() const { return data() + m_size; }
+
+    /// The object keeping the data alive.
+    const std::shared_ptr<void> &owner() const { return m_owner; }
+
+private:
+    friend struct detail::arrow_array_traits<arrow_array>;
+
+    const T *m_data = nullptr;
+    ssize_t m_size = 0;
+    ssize_t m_offset = 0;
+    const std::uint8_t *m_validity = nullptr;
+    ssize_t m_null_count = 0;
+    std::shared_ptr<void> m_owner;
+};
+
+/** \rst
+    A read-only view of an Arrow array of UTF-8 strings (``string`` or ``large_string``), with
+    an optional validity bitmap marking null elements. It is exchanged with Python like
+    ``arrow_array``.
+\endrst */
+class arrow_string_array {
+public:
+    arrow_string_array() = default;
+
+    /// Packs ``values`` into a new ``string`` array (``large_string`` beyond 2 GiB).
+    explicit arrow_string_array(const std::vector<std::string> &values) {
+        size_t chars = 0;
+        for (const auto &value : values) {
+            chars += value.size();
+        }
+        m_large = chars > static_cast<size_t>(INT32_MAX);
+        if (m_large) {
+            pack<std::int64_t>(values, chars);
+        } else {
+            pack<std::int32_t>(values, chars);
+        }
+    }
+
+    ssize_t size() const { return m_size; }
+    ssize_t null_count() const { return m_null_count; }
+    bool is_valid(ssize_t i) const {
+        return m_validity == nullptr || detail::arrow_bit(m_validity, m_offset + i);
+    }
+
+    /// The UTF-8 bytes of the element ``i``, not null-terminated.
+    const char *value_data(ssize_t i) const { return m_chars + offset(m_offset + i); }
+    ssize_t value_size(ssize_t i) const {
+        return offset(m_offset + i + 1) - offset(m_offset + i);
+    }
+    std::string operator[](ssize_t i) const {
+        return std::string(value_data(i), static_cast<size_t>(value_size(i)));
+    }
+
+    /// The object keeping the data alive.
+    const std::shared_ptr<void> &owner() const { return m_owner; }
+
+private:
+    friend struct detail::arrow_array_traits<arrow_string_array>;
+
+    ssize_t offset(ssize_t i) const {
+        return m_large ? static_cast<ssize_t>(static_cast<const std::int64_t *>(m_offsets)[i])
+                       : static_cast<ssize_t>(static_cast<const std::int32_t *>(m_offsets)[i]);
+    }
+
+    template <typename Offset>
+    void pack(const std::vector<std::string> &values, size_t chars) {
+        struct storage {
+            std::vector<Offset> offsets;
+            std::string chars;
+        };
+        auto packed = std::make_shared<storage>();
+        packed->offsets.reserve(values.size() + 1);
+        packed->offsets.push_back(0);
+        packed->chars.reserve(chars);
+        for (const auto &value : values) {
+            packed->chars += value;
+            packed->offsets.push_back(static_cast<Offset>(packed->chars.size()));
+        }
+        m_size = static_cast<ssize_t>(values.size());
+        m_offsets = packed->offsets.data();
+        m_chars = packed->chars.data();
+        m_owner = std::move(packed);
+    }
+
+    const void *m_offsets = nullptr;
+    const char *m_chars = nullptr;
+    bool m_large = false;
+    ssize_t m_size = 0;
+    ssize_t m_offset = 0;
+    const std::uint8_t *m_validity = nullptr;
+    ssize_t m_null_count = 0;
+    std::shared_ptr<void> m_owner;
+};
+
+/** \rst
+    A column made of several ``arrow_array`` or ``arrow_string_array`` chunks, exchanged with
+    Python through ``__arrow_c_stream__`` (e.g. a ``pyarrow.ChunkedArray``). A single array
+    implementing ``__arrow_c_array__`` is also accepted, as one chunk.
+\endrst */
+template <typename Array>
+class arrow_chunked_array {
+public:
+    arrow_chunked_array() = default;
+    explicit arrow_chunked_array(std::vector<Array> chunks) : m_chunks(std::move(chunks)) {}
+
+    const std::vector<Array> &chunks() const { return m_chunks; }
+
+    /// Total number of elements.
+    ssize_t size() const {
+        ssize_t size = 0;
+        for (const auto &chunk : m_chunks) {
+            size += chunk.size();
+        }
+        return size;
+    }
+
+    ssize_t null_count() const {
+        ssize_t nulls = 0;
+        for (const auto &chunk : m_chunks) {
+            nulls += chunk.null_count();
+        }
+        return nulls;
+    }
+
+private:
+    std::vector<Array> m_chunks;
+};
+
+PYBIND11_NAMESPACE_BEGIN(detail)
+
+template <typename T>
+struct arrow_array_traits<arrow_array<T>> {
+    static const char *format() { return arrow_format<T>::get(); }
+    static bool accepts(const char *format) {
+        return std::strcmp(format, arrow_format<T>::get()) == 0;
+    }
+
+    static bool from_view(const arrow_view &view, arrow_array<T> &result) {
+        if (view.buffers.size() != 2) {
+            return false;
+        }
+        result.m_validity = static_cast<const std::uint8_t *>(view.buffers[0]);
+        result.m_data = static_cast<const T *>(view.buffers[1]);
+        result.m_size = view.length;
+        result.m_offset = view.offset;
+        result.m_null_count = view.null_count;
+        result.m_owner = view.owner;
+        return true;
+    }
+
+    static arrow_view to_view(const arrow_array<T> &array) {
+        arrow_view view;
+        view.format = format();
+        view.length = array.m_size;
+        view.null_count = array.m_null_count;
+        view.offset = array.m_offset;
+        view.buffers = {array.m_validity, array.m_data};
+        view.owner = array.m_owner;
+        return view;
+    }
+};
+
+template <>
+struct arrow_array_traits<arrow_string_array> {
+    static bool accepts(const char *format) {
+        return std::strcmp(format, "u") == 0 || std::strcmp(format, "U") == 0;
+    }
+
+    static bool from_view(const arrow_view &view, arrow_string_array &result) {
+        if (view.buffers.size() != 3) {
+            return false;
+        }
+        result.m_validity = static_cast<const std::uint8_t *>(view.buffers[0]);
+        result.m_offsets = view.buffers[1];
+        result.m_chars = static_cast<const char *>(view.buffers[2]);
+        result.m_large = view.format == "U";
+        result.m_size = view.length;
+        result.m_offset = view.offset;
+        result.m_null_count = view.null_count;
+        result.m_owner = view.owner;
+        return true;
+    }
+
+    static arrow_view to_view(const arrow_string_array &array) {
+        arrow_view view;
+        view.format = array.m_large ? "U" : "u";
+        view.length = array.m_size;
+        view.null_count = array.m_null_count;
+        view.offset = array.m_offset;
+        view.buffers = {array.m_validity, array.m_offsets, array.m_chars};
+        view.owner = array.m_owner;
+        return view;
+    }
+};
+
+template <typename Array>
+struct arrow_array_caster {
+    using traits = arrow_array_traits<Array>;
+
+public:
+    PYBIND11_TYPE_CASTER(Array, const_name("typing.Any"));
+
+    bool load(handle src, bool) {
+        arrow_view view;
+        return arrow_import_array(src, &traits::accepts, view) && traits::from_view(view, value);
+    }
+
+    static handle cast(const Array &src, return_value_policy, handle) {
+        return arrow_export(traits::to_view(src)).release();
+    }
+};
+
+template <typename T>
+struct type_caster<arrow_array<T>> : arrow_array_caster<arrow_array<T>> {};
+
+template <>
+struct type_caster<arrow_string_array> : arrow_array_caster<arrow_string_array> {};
+
+template <typename Array>
+struct type_caster<arrow_chunked_array<Array>> {
+    using traits = arrow_array_traits<Array>;
+
+public:
+    PYBIND11_TYPE_CASTER(arrow_chunked_array<Array>, const_name("typing.Any"));
+
+    bool load(handle src, bool) {
+        std::vector<arrow_view> views;
+        if (!arrow_import_stream(src, &traits::accepts, views)) {
+            views.clear();
+            views.emplace_back();
+            if (!arrow_import_array(src, &traits::accepts, views.back())) {
+                return false;
+            }
+        }
+        std::vector<Array> chunks(views.size());
+        for (size_t i = 0; i < views.size(); ++i) {
+            if (!traits::from_view(views[i], chunks[i])) {
+                return false;
+            }
+        }
+        value = arrow_chunked_array<Array>(std::move(chunks));
+        return true;
+    }
+
+    static handle cast(const arrow_chunked_array<Array> &src, return_value_policy, handle) {
+        std::vector<arrow_view> views;
+        views.reserve(src.chunks().size());
+        for (const auto &chunk : src.chunks()) {
+            views.push_back(traits::to_view(chunk));
+        }
+        // The format of an empty stream of strings is that of a `string` array.
+        std::string format = views.empty() ? traits::to_view(Array()).format : views[0].format;
+        for (const auto &view : views) {
+            if (view.format != format) {
+                throw value_error("arrow_chunked_array: string chunks must all be either "
+                                  "string or large_string arrays");
+            }
+        }
+        return arrow_export_stream(std::move(format), std::move(views)).release();
+    }
+};
+
+PYBIND11_NAMESPACE_END(detail)
+PYBIND11_NAMESPACE_END(PYBIND11_NAMESPACE)
@@ -82,10 +82,27 @@ struct dynamic_attr {};
 /// Annotation which enables the buffer protocol for a type
 struct buffer_protocol {};
 
+/// Annotation which omits the weak reference list from instances of a type, to reduce their
+/// memory footprint. Requires `PYBIND11_INTERNALS_VERSION >= 12`: before that, the weak reference
+/// list is part of the `instance` layout shared by all extension modules.
+struct no_weakref {
+#if PYBIND11_INTERNALS_VERSION < 12
+    template <typename T = void>
+    no_weakref() {
+        static_assert(detail::always_false<T>::value,
+                      "py::no_weakref() requires PYBIND11_INTERNALS_VERSION >= 12");
+    }
+#endif
+};
+
 /// Annotation which enables releasing the GIL before calling the C++ destructor of wrapped
 /// instances (pybind/pybind11#1446).
 struct release_gil_before_calling_cpp_dtor {};
 
+/// Annotation which moves the C++ destructor calls of wrapped instances to a background thread
+/// (see `flush_deferred_cpp_dtors()`). The destructors must not use the Python C API.
+struct deferred_cpp_dtor {};
+
 /// Annotation which requests that a special metaclass is created for a type
 struct metaclass {
     handle value;
@@ -178,6 +195,7 @@ struct undefined_t;
 template <op_id id, op_type ot, typename L = undefined_t, typename R = undefined_t>
 struct op_;
 void keep_alive_impl(size_t Nurse, size_t Patient, function_call &call, handle ret);
+void keep_alive_impl(handle nurse, handle patient);
 
 /// Internal data structure which holds metadata about a keyword argument
 struct argument_record {
@@ -284,7 +302,8 @@ struct function_record {
 struct type_record {
     PYBIND11_NOINLINE type_record()
         : multiple_inheritance(false), dynamic_attr(false), buffer_protocol(false),
-          module_local(false), is_final(false), release_gil_before_calling_cpp_dtor(false) {}
+          module_local(false), is_final(false), release_gil_before_calling_cpp_dtor(false),
+          deferred_cpp_dtor(false), no_weakref(false) {}
 
     /// Handle to the parent scope
     handle scope;
@@ -349,6 +368,12 @@ struct type_record {
     /// Solves pybind/pybind11#1446
     bool release_gil_before_calling_cpp_dtor : 1;
 
+    /// Run the C++ destructor on the deferred destruction worker thread?
+    bool deferred_cpp_dtor : 1;
+
+    /// Omit the weak reference list from instances?
+    bool no_weakref : 1;
+
     holder_enum_t holder_enum_v = holder_enum_t::undefined;
 
     PYBIND11_NOINLINE void add_base(const std::type_info &base, void *(*caster)(void *) ) {
@@ -635,6 +660,16 @@ struct process_attribute<release_gil_before_calling_cpp_dtor>
     }
 };
 
+template <>
+struct process_attribute<no_weakref> : process_attribute_default<no_weakref> {
+    static void init(const no_weakref &, type_record *r) { r->no_weakref = true; }
+};
+
+template <>
+struct process_attribute<deferred_cpp_dtor> : process_attribute_default<deferred_cpp_dtor> {
+    static void init(const deferred_cpp_dtor &, type_record *r) { r->deferred_cpp_dtor = true; }
+};
+
 /// Process a 'prepend' attribute, putting this at the beginning of the overload chain
 template <>
 struct process_attribute<prepend> : process_attribute_default<prepend> {
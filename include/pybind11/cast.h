@@ -243,6 +243,22 @@ public:
             return false;
         }
 
+#if PY_VERSION_HEX >= 0x030C0000 && !defined(PYPY_VERSION) && !defined(GRAALVM_PYTHON)
+        // Fast path for the most common case: a small `int`, read directly from the object.
+        if (std::is_integral<T>::value && PyLong_CheckExact(src.ptr())) {
+            const auto *src_long = reinterpret_cast<PyLongObject *>(src.ptr());
+            if (PyUnstable_Long_IsCompact(src_long)) {
+                Py_ssize_t compact_value = PyUnstable_Long_CompactValue(src_long);
+                if ((std::is_unsigned<T>::value && compact_value < 0)
+                    || static_cast<Py_ssize_t>(static_cast<T>(compact_value)) != compact_value) {
+                    return false;
+                }
+                value = static_cast<T>(compact_value);
+                return true;
+            }
+        }
+#endif
+
 #if !defined(PYPY_VERSION)
         auto index_check = [](PyObject *o) { return PyIndex_Check(o); };
 #else
@@ -741,6 +757,130 @@ public:
     using cast_op_type = pybind11::detail::cast_op_type<_T>;
 };
 
+// 32-bit FNV-1a hash, selecting the slot of a string in the `interned_str_cache`.
+inline size_t interned_str_hash(const char *data, size_t size) {
+    std::uint32_t hash = 2166136261u;
+    for (size_t i = 0; i < size; ++i) {
+        hash ^= static_cast<unsigned char>(data[i]);
+        hash *= 16777619u;
+    }
+    return hash;
+}
+
+// Returns a new reference to a `str` decoded from UTF-8, reusing the object returned for the
+// same contents before if it is still cached for the current interpreter. Returns nullptr with
+// a Python error set if the contents are not valid UTF-8.
+inline PyObject *interned_str_from_utf8(const char *data, size_t size) {
+    if (size > interned_str_cache::max_length) {
+        return PyUnicode_DecodeUTF8(data, static_cast<ssize_t>(size), nullptr);
+    }
+    auto &cache = get_local_internals().interned_strs;
+    PyObject *&slot
+        = cache.slots[interned_str_hash(data, size) & (interned_str_cache::num_slots - 1)];
+    {
+#ifdef Py_GIL_DISABLED
+        std::unique_lock<pymutex> lock(cache.mutex);
+#endif
+        if (slot != nullptr) {
+            Py_ssize_t length = 0;
+            const char *cached = PyUnicode_AsUTF8AndSize(slot, &length);
+            if (cached == nullptr) {
+                PyErr_Clear();
+            } else if (static_cast<size_t>(length) == size
+                       && (size == 0 || std::memcmp(cached, data, size) == 0)) {
+                Py_INCREF(slot);
+                return slot;
+            }
+        }
+    }
+    PyObject *result = PyUnicode_DecodeUTF8(data, static_cast<ssize_t>(size), nullptr);
+    if (result == nullptr) {
+        return nullptr;
+    }
+#if (PY_VERSION_HEX < 0x030C0000 || PY_VERSION_HEX >= 0x030D0000) && !defined(Py_GIL_DISABLED)
+    // Not on Python 3.12 nor on free-threaded builds, which make all interned strings immortal:
+    // the cache would no longer bound the number of strings kept alive, nor release them in
+    // `clear_interned_str_cache()`.
+    PyUnicode_InternInPlace(&result);
+#endif
+    PyObject *evicted = nullptr;
+    {
+#ifdef Py_GIL_DISABLED
+        std::unique_lock<pymutex> lock(cache.mutex);
+#endif
+        evicted = slot;
+        Py_INCREF(result);
+        slot = result;
+    }
+    Py_XDECREF(evicted);
+    return result;
+}
+
+PYBIND11_NAMESPACE_END(detail)
+
+/** \rst
+    Wraps a string returned from C++ to Python, so that repeated values are returned as the same
+    ``str`` object, taken from a bounded per-interpreter cache. Intended for short, frequently
+    repeated values such as tags or column names. Strings longer than 64 bytes are not cached.
+\endrst */
+class interned_str {
+public:
+    interned_str() = default;
+    explicit interned_str(std::string value) : value_(std::move(value)) {}
+    explicit interned_str(const char *value) : value_(value) {}
+
+    const std::string &value() const { return value_; }
+
+private:
+    std::string value_;
+};
+
+/// Releases the ``str`` objects cached for ``py::interned_str`` in the current interpreter.
+inline void clear_interned_str_cache() {
+    auto &cache = detail::get_local_internals().interned_strs;
+    std::vector<PyObject *> evicted;
+    evicted.reserve(detail::interned_str_cache::num_slots);
+    {
+#ifdef Py_GIL_DISABLED
+        std::unique_lock<detail::pymutex> lock(cache.mutex);
+#endif
+        for (auto &slot : cache.slots) {
+            if (slot != nullptr) {
+                evicted.push_back(slot);
+                slot = nullptr;
+            }
+        }
+    }
+    for (auto *str : evicted) {
+        Py_DECREF(str);
+    }
+}
+
+PYBIND11_NAMESPACE_BEGIN(detail)
+
+template <>
+class type_caster<interned_str> {
+public:
+    bool load(handle src, bool convert) {
+        make_caster<std::string> caster;
+        if (!caster.load(src, convert)) {
+            return false;
+        }
+        value = interned_str(cast_op<std::string &&>(std::move(caster)));
+        return true;
+    }
+
+    static handle cast(const interned_str &src, return_value_policy, handle) {
+        handle result = interned_str_from_utf8(src.value().data(), src.value().size());
+        if (!result) {
+            throw error_already_set();
+        }
+        return result;
+    }
+
+    PYBIND11_TYPE_CASTER(interned_str, const_name(PYBIND11_STRING_NAME));
+};
+
 // Base implementation for std::tuple and std::pair
 template <template <typename...> class Tuple, typename... Ts>
 class tuple_caster {
@@ -2357,6 +2497,85 @@ object object_api<Derived>::call(Args &&...args) const {
 
 PYBIND11_NAMESPACE_END(detail)
 
+/// A Python iterable that C++ code iterates lazily, converting one item at a time to `T`:
+///
+///     m.def("ingest", [](py::iterable_view<Record> records) {
+///         for (Record r : records) { ... }
+///     });
+///
+/// Unlike a `std::vector<T>` argument, the items are neither materialized in a `tuple` nor
+/// in a C++ container, so generators of any length are processed in constant memory. The
+/// items are pulled from the Python iterator, so the GIL must be held while iterating, and a
+/// one-shot iterable (e.g. a generator) can only be iterated once. An item that cannot be
+/// converted to `T` raises `cast_error` when it is reached.
+template <typename T>
+class iterable_view : public iterable {
+public:
+    PYBIND11_OBJECT_DEFAULT(iterable_view, iterable, detail::PyIterable_Check)
+
+    class iterator {
+    public:
+        using iterator_category = std::input_iterator_tag;
+        using difference_type = ssize_t;
+        using value_type = T;
+        using reference = T;
+        using pointer = void;
+
+        /// Past-the-end iterator
+        iterator() = default;
+
+        explicit iterator(pybind11::iterator source) : it(std::move(source)) {}
+
+        reference operator*() const {
+            fetch();
+            return item.template cast<T>();
+        }
+
+        // The next item is only pulled from the Python iterator when it is needed, so that
+        // stopping early does not consume an extra item.
+        iterator &operator++() {
+            fetch();
+            item = object();
+            fetched = false;
+            return *this;
+        }
+
+        friend bool operator==(const iterator &a, const iterator &b) {
+            a.fetch();
+            b.fetch();
+            return a.item.ptr() == b.item.ptr();
+        }
+        friend bool operator!=(const iterator &a, const iterator &b) { return !(a == b); }
+
+    private:
+        void fetch() const {
+            if (fetched || !it) {
+                return;
+            }
+            item = reinterpret_steal<object>(PyIter_Next(it.ptr()));
+            if (!item && PyErr_Occurred()) {
+                throw error_already_set();
+            }
+            fetched = true;
+        }
+
+        pybind11::iterator it;
+        mutable object item;
+        mutable bool fetched = false;
+    };
+
+    iterator begin() const { return iterator(iter(*this)); }
+    iterator end() const { return iterator(); }
+};
+
+PYBIND11_NAMESPACE_BEGIN(detail)
+template <typename T>
+struct handle_type_name<iterable_view<T>> {
+    static constexpr auto name
+        = const_name("collections.abc.Iterable[") + make_caster<T>::name + const_name("]");
+};
+PYBIND11_NAMESPACE_END(detail)
+
 template <typename T>
 handle type::handle_of() {
     static_assert(std::is_base_of<detail::type_caster_generic, detail::make_caster<T>>::value,
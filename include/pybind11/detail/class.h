@@ -464,9 +464,15 @@ inline void clear_instance(PyObject *self) {
     // Deallocate the value/holder layout internals:
     instance->deallocate_layout();
 
+#if PYBIND11_INTERNALS_VERSION >= 12
+    if (Py_TYPE(self)->tp_weaklistoffset != 0) {
+        PyObject_ClearWeakRefs(self);
+    }
+#else
     if (instance->weakrefs) {
         PyObject_ClearWeakRefs(self);
     }
+#endif
 
     PyObject **dict_ptr = _PyObject_GetDictPtr(self);
     if (dict_ptr) {
@@ -499,6 +505,27 @@ extern "C" inline void pybind11_object_dealloc(PyObject *self) {
     Py_DECREF(type);
 }
 
+/// `__sizeof__` for all pybind11 types: the Python object itself, the out-of-line value/holder
+/// layout (if any), and the C++ values owned by the instance (as reported by `sizeof`).
+extern "C" inline PyObject *pybind11_object_sizeof(PyObject *self, PyObject *) {
+    auto *inst = reinterpret_cast<instance *>(self);
+    auto size = static_cast<size_t>(Py_TYPE(self)->tp_basicsize);
+    const auto &tinfo = all_type_info(Py_TYPE(self));
+    if (!inst->simple_layout) {
+        size_t space = size_in_ptrs(tinfo.size());
+        for (auto *t : tinfo) {
+            space += 1 + t->holder_size_in_ptrs;
+        }
+        size += space * sizeof(void *);
+    }
+    for (auto &v_h : values_and_holders(inst)) {
+        if (v_h && (inst->owned || v_h.holder_constructed())) {
+            size += v_h.type->type_size;
+        }
+    }
+    return PyLong_FromSize_t(size);
+}
+
 PYBIND11_WARNING_PUSH
 PYBIND11_WARNING_DISABLE_GCC("-Wredundant-decls")
 
@@ -537,8 +564,15 @@ inline PyObject *make_object_base_type(PyTypeObject *metaclass) {
     type->tp_init = pybind11_object_init;
     type->tp_dealloc = pybind11_object_dealloc;
 
+    static PyMethodDef methods[]
+        = {{"__sizeof__", pybind11_object_sizeof, METH_NOARGS, nullptr},
+           {nullptr, nullptr, 0, nullptr}};
+    type->tp_methods = methods;
+
+#if PYBIND11_INTERNALS_VERSION < 12
     /* Support weak references (needed for the keep_alive feature) */
     type->tp_weaklistoffset = offsetof(instance, weakrefs);
+#endif
 
     if (PyType_Ready(type) < 0) {
         pybind11_fail("PyType_Ready failed in make_object_base_type(): " + error_string());
@@ -582,8 +616,14 @@ inline void enable_dynamic_attributes(PyHeapTypeObject *heap_type) {
     auto *type = &heap_type->ht_type;
     type->tp_flags |= Py_TPFLAGS_HAVE_GC;
 #ifdef PYBIND11_BACKWARD_COMPATIBILITY_TP_DICTOFFSET
-    type->tp_dictoffset = type->tp_basicsize;           // place dict at the end
-    type->tp_basicsize += (ssize_t) sizeof(PyObject *); // and allocate enough space for it
+#    if PYBIND11_INTERNALS_VERSION >= 12
+    // A dict slot of the primary base (already included in tp_basicsize) is inherited.
+    if (type->tp_base->tp_dictoffset == 0)
+#    endif
+    {
+        type->tp_dictoffset = type->tp_basicsize;           // place dict at the end
+        type->tp_basicsize += (ssize_t) sizeof(PyObject *); // and allocate enough space for it
+    }
 #else
     type->tp_flags |= Py_TPFLAGS_MANAGED_DICT;
 #endif
@@ -596,6 +636,16 @@ inline void enable_dynamic_attributes(PyHeapTypeObject *heap_type) {
     type->tp_getset = getset;
 }
 
+#if PYBIND11_INTERNALS_VERSION >= 12
+/// Give instances of this type a weak reference list (needed for the keep_alive feature). The
+/// slot must come last (after the `__dict__` slot, if any), for multiple inheritance to work.
+inline void enable_weak_references(PyHeapTypeObject *heap_type) {
+    auto *type = &heap_type->ht_type;
+    type->tp_weaklistoffset = type->tp_basicsize;
+    type->tp_basicsize += (ssize_t) sizeof(PyObject *);
+}
+#endif
+
 /// buffer_protocol: Fill in the view as specified by flags.
 extern "C" inline int pybind11_getbuffer(PyObject *obj, Py_buffer *view, int flags) {
     // Look for a `get_buffer` implementation in this type's info or any bases (following MRO).
@@ -765,7 +815,13 @@ inline PyObject *make_new_python_type(const type_record &rec) {
     type->tp_name = full_name;
     type->tp_doc = tp_doc;
     type->tp_base = type_incref((PyTypeObject *) base);
+#if PYBIND11_INTERNALS_VERSION >= 12
+    // Start from the layout of the primary base: it may already include the `__dict__` and weak
+    // reference list slots.
+    type->tp_basicsize = type->tp_base->tp_basicsize;
+#else
     type->tp_basicsize = static_cast<ssize_t>(sizeof(instance));
+#endif
     if (!bases.empty()) {
         type->tp_bases = bases.release().ptr();
     }
@@ -789,6 +845,12 @@ inline PyObject *make_new_python_type(const type_record &rec) {
         enable_dynamic_attributes(heap_type);
     }
 
+#if PYBIND11_INTERNALS_VERSION >= 12
+    if (!rec.no_weakref && type->tp_base->tp_weaklistoffset == 0) {
+        enable_weak_references(heap_type);
+    }
+#endif
+
     if (rec.buffer_protocol) {
         enable_buffer_protocol(heap_type);
     }
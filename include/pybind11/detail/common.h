@@ -46,6 +46,31 @@
 
 #include "pybind11_namespace_macros.h"
 
+/// Tracks the `internals`, `type_info` and `instance` ABI version independent of the main library
+/// version.
+///
+/// Some portions of the code use an ABI that is conditional depending on this
+/// version number.  That allows ABI-breaking changes to be "pre-implemented".
+/// Once the default version number is incremented, the conditional logic that
+/// no longer applies can be removed.  Additionally, users that need not
+/// maintain ABI compatibility can increase the version number in order to take
+/// advantage of any functionality/efficiency improvements that depend on the
+/// newer ABI.
+///
+/// WARNING: If you choose to manually increase the ABI version, note that
+/// pybind11 may not be tested as thoroughly with a non-default ABI version, and
+/// further ABI-incompatible changes may be made before the ABI is officially
+/// changed to the new version.
+#ifndef PYBIND11_INTERNALS_VERSION
+//   REMINDER for next version bump: remove loader_life_support_tls, and the
+//   `PYBIND11_INTERNALS_VERSION < 12` branches for `instance::weakrefs`
+#    define PYBIND11_INTERNALS_VERSION 11
+#endif
+
+#if PYBIND11_INTERNALS_VERSION < 11
+#    error "PYBIND11_INTERNALS_VERSION 11 is the minimum for all platforms for pybind11v3."
+#endif
+
 #if !(defined(_MSC_VER) && __cplusplus == 199711L)
 #    if __cplusplus >= 201402L
 #        define PYBIND11_CPP14
@@ -210,6 +235,13 @@
 #    define PYBIND11_HAS_STRING_VIEW 1
 #endif
 
+// std::span
+#if defined(PYBIND11_CPP20) && defined(__has_include)
+#    if __has_include(<span>)
+#        define PYBIND11_HAS_SPAN 1
+#    endif
+#endif
+
 #if (defined(PYPY_VERSION) || defined(GRAALVM_PYTHON)) && !defined(PYBIND11_SIMPLE_GIL_MANAGEMENT)
 #    define PYBIND11_SIMPLE_GIL_MANAGEMENT
 #endif
@@ -617,8 +649,11 @@ struct instance {
         void *simple_value_holder[1 + instance_simple_holder_in_ptrs()];
         nonsimple_values_and_holders nonsimple;
     };
-    /// Weak references
+#if PYBIND11_INTERNALS_VERSION < 12
+    /// Weak references. With PYBIND11_INTERNALS_VERSION >= 12, the weak reference list is
+    /// appended to the instance by each class (unless `py::no_weakref()` is specified).
     PyObject *weakrefs;
+#endif
     /// If true, the pointer is owned which means we're free to manage it with a holder.
     bool owned : 1;
     /**
@@ -0,0 +1,141 @@
+// Copyright (c) 2025 The Pybind Development Team.
+// All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+
+#pragma once
+
+#include "common.h"
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <mutex>
+#include <system_error>
+#include <thread>
+
+PYBIND11_NAMESPACE_BEGIN(PYBIND11_NAMESPACE)
+PYBIND11_NAMESPACE_BEGIN(detail)
+
+// Bounded queue of C++ destructor calls, drained by a single background worker thread.
+// Used by `py::class_` types annotated with `py::deferred_cpp_dtor()`, so that expensive C++
+// destructors do not run on the thread releasing the last Python reference.
+// There is one queue per extension module (this is a header-only, non-exported singleton).
+// The queue never calls into the Python C API, it is safe to use with or without the GIL.
+class deferred_cpp_dtor_queue {
+public:
+    using destroy_fn = void (*)(void *);
+
+    // Intentionally leaked: the (detached) worker thread may still be blocked on the
+    // condition variable while static destructors run at process exit.
+    static deferred_cpp_dtor_queue &get() {
+        static auto *queue = new deferred_cpp_dtor_queue();
+        return *queue;
+    }
+
+    // Returns false if the destructor call was not queued, because the queue is at capacity
+    // or the worker thread could not be started. The caller must then call `destroy(ptr)`.
+    bool push(destroy_fn destroy, void *ptr) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (tasks_.size() >= capacity_ || !start_worker()) {
+            return false;
+        }
+        tasks_.push_back({destroy, ptr});
+        task_added_.notify_one();
+        return true;
+    }
+
+    // Blocks until all destructor calls queued so far have completed. If there is no worker thread
+    // to run them and none can be started, they run on the calling thread.
+    void flush() {
+        std::unique_lock<std::mutex> lock(mutex_);
+        if (!tasks_.empty() && !start_worker()) {
+            while (!tasks_.empty()) {
+                task t = tasks_.front();
+                tasks_.pop_front();
+                lock.unlock();
+                t.destroy(t.ptr);
+                lock.lock();
+            }
+        }
+        drained_.wait(lock, [this] { return tasks_.empty() && in_progress_ == 0; });
+    }
+
+    // Number of destructor calls queued or in progress.
+    size_t pending() {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return tasks_.size() + in_progress_;
+    }
+
+    void set_capacity(size_t capacity) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        capacity_ = capacity;
+    }
+
+    size_t capacity() {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return capacity_;
+    }
+
+    // `os.register_at_fork()` hooks: the worker thread does not exist in a forked child process,
+    // it is started again if destructor calls were queued at the time of the fork, else on
+    // demand. Destructor calls in progress at the time of the fork are abandoned in the child.
+    void before_fork() { mutex_.lock(); }
+    void after_fork_parent() { mutex_.unlock(); }
+    void after_fork_child() {
+        worker_started_ = false;
+        in_progress_ = 0;
+        if (!tasks_.empty()) {
+            start_worker(); // Else `flush()` runs them.
+        }
+        mutex_.unlock();
+    }
+
+private:
+    struct task {
+        destroy_fn destroy;
+        void *ptr;
+    };
+
+    deferred_cpp_dtor_queue() = default;
+
+    // Starts the worker thread if it is not running. Must be called with `mutex_` held.
+    bool start_worker() {
+        if (!worker_started_) {
+            try {
+                std::thread(&deferred_cpp_dtor_queue::run, this).detach();
+            } catch (const std::system_error &) {
+                return false;
+            }
+            worker_started_ = true;
+        }
+        return true;
+    }
+
+    void run() {
+        std::unique_lock<std::mutex> lock(mutex_);
+        while (true) {
+            task_added_.wait(lock, [this] { return !tasks_.empty(); });
+            task t = tasks_.front();
+            tasks_.pop_front();
+            ++in_progress_;
+            lock.unlock();
+            t.destroy(t.ptr);
+            lock.lock();
+            --in_progress_;
+            if (tasks_.empty() && in_progress_ == 0) {
+                drained_.notify_all();
+            }
+        }
+    }
+
+    std::mutex mutex_;
+    std::condition_variable task_added_;
+    std::condition_variable drained_;
+    std::deque<task> tasks_;
+    size_t in_progress_ = 0;
+    size_t capacity_ = 1024;
+    bool worker_started_ = false;
+};
+
+PYBIND11_NAMESPACE_END(detail)
+PYBIND11_NAMESPACE_END(PYBIND11_NAMESPACE)
@@ -83,6 +83,21 @@ inline Class *construct_or_initialize(Args &&...args) {
     return new Class{std::forward<Args>(args)...};
 }
 
+// Like construct_or_initialize, but allocates the object together with its std::shared_ptr control
+// block (through std::make_shared).
+template <typename Class,
+          typename... Args,
+          detail::enable_if_t<std::is_constructible<Class, Args...>::value, int> = 0>
+inline std::shared_ptr<Class> make_shared_or_initialize(Args &&...args) {
+    return std::make_shared<Class>(std::forward<Args>(args)...);
+}
+template <typename Class,
+          typename... Args,
+          detail::enable_if_t<!std::is_constructible<Class, Args...>::value, int> = 0>
+inline std::shared_ptr<Class> make_shared_or_initialize(Args &&...args) {
+    return std::make_shared<Class>(Class{std::forward<Args>(args)...});
+}
+
 // Attempts to constructs an alias using a `Alias(Cpp &&)` constructor.  This allows types with
 // an alias to provide only a single Cpp factory function as long as the Alias can be
 // constructed from an rvalue reference of the base Cpp type.  This means that Alias classes
@@ -362,6 +377,74 @@ struct alias_constructor {
     }
 };
 
+// Implementing class for py::init_shared<...>()
+template <typename... Args>
+struct shared_constructor {
+    template <typename Class>
+    using holder_is_shared = bool_constant<is_smart_holder<Holder<Class>>::value
+                                           || std::is_same<Holder<Class>,
+                                                           std::shared_ptr<Cpp<Class>>>::value>;
+
+    template <typename Class, typename... Extra, enable_if_t<!Class::has_alias, int> = 0>
+    static void execute(Class &cl, const Extra &...extra) {
+        static_assert(holder_is_shared<Class>::value,
+                      "py::init_shared() requires a py::smart_holder or std::shared_ptr holder");
+        cl.def(
+            "__init__",
+            [](value_and_holder &v_h,
+               Args... args) { // NOLINT(performance-unnecessary-value-param)
+                auto shd_ptr = make_shared_or_initialize<Cpp<Class>>(std::forward<Args>(args)...);
+                construct<Class>(v_h, std::move(shd_ptr), false);
+            },
+            is_new_style_constructor(),
+            extra...);
+    }
+
+    template <
+        typename Class,
+        typename... Extra,
+        enable_if_t<Class::has_alias && std::is_constructible<Cpp<Class>, Args...>::value, int>
+        = 0>
+    static void execute(Class &cl, const Extra &...extra) {
+        static_assert(holder_is_shared<Class>::value,
+                      "py::init_shared() requires a py::smart_holder or std::shared_ptr holder");
+        cl.def(
+            "__init__",
+            [](value_and_holder &v_h, Args... args) {
+                if (Py_TYPE(v_h.inst) == v_h.type->type) {
+                    auto shd_ptr
+                        = make_shared_or_initialize<Cpp<Class>>(std::forward<Args>(args)...);
+                    construct<Class>(v_h, std::move(shd_ptr), false);
+                } else {
+                    auto shd_ptr
+                        = make_shared_or_initialize<Alias<Class>>(std::forward<Args>(args)...);
+                    construct<Class>(v_h, std::move(shd_ptr), true);
+                }
+            },
+            is_new_style_constructor(),
+            extra...);
+    }
+
+    template <
+        typename Class,
+        typename... Extra,
+        enable_if_t<Class::has_alias && !std::is_constructible<Cpp<Class>, Args...>::value, int>
+        = 0>
+    static void execute(Class &cl, const Extra &...extra) {
+        static_assert(holder_is_shared<Class>::value,
+                      "py::init_shared() requires a py::smart_holder or std::shared_ptr holder");
+        cl.def(
+            "__init__",
+            [](value_and_holder &v_h, Args... args) {
+                auto shd_ptr
+                    = make_shared_or_initialize<Alias<Class>>(std::forward<Args>(args)...);
+                construct<Class>(v_h, std::move(shd_ptr), true);
+            },
+            is_new_style_constructor(),
+            extra...);
+    }
+};
+
 // Implementation class for py::init(Func) and py::init(Func, AliasFunc)
 template <typename CFunc,
           typename AFunc = void_type (*)(),
@@ -487,6 +570,70 @@ void setstate(value_and_holder &v_h, std::pair<T, O> &&result, bool need_alias)
     }
 }
 
+inline object pickle_import_attr(const char *module_name, const char *name) {
+    auto module = reinterpret_steal<object>(PyImport_ImportModule(module_name));
+    if (!module) {
+        throw error_already_set();
+    }
+    return module.attr(name);
+}
+
+/// Builds the `__reduce_ex__` result for `py::pickle()` with a `buffer_info` state. With
+/// protocol 5 the payload is a `pickle.PickleBuffer` referring to the C++ storage (which can
+/// be transferred out-of-band); older protocols fall back to a `bytes` copy.
+inline tuple pickle_buffer_reduce(handle self, const buffer_info &info, int protocol) {
+    if (info.strides != c_strides(info.shape, info.itemsize)) {
+        throw value_error("py::pickle(): the buffer_info returned by __getstate__ must describe "
+                          "a C-contiguous buffer");
+    }
+    auto nbytes = info.size * info.itemsize;
+    object payload;
+    if (protocol >= 5) {
+        auto view = memoryview::from_memory(info.ptr, nbytes, info.readonly);
+        // The view does not own the memory: keep `self` alive for as long as the view (or any
+        // buffer exported from it by the pickler) is around.
+        keep_alive_impl(view, self);
+        payload = pickle_import_attr("pickle", "PickleBuffer")(view);
+    } else {
+        payload = bytes(static_cast<const char *>(info.ptr), static_cast<size_t>(nbytes));
+    }
+    tuple shape(info.shape.size());
+    for (size_t i = 0; i < info.shape.size(); ++i) {
+        shape[i] = int_(info.shape[i]);
+    }
+    return pybind11::make_tuple(pickle_import_attr("copyreg", "__newobj__"),
+                                pybind11::make_tuple(type::handle_of(self)),
+                                pybind11::make_tuple(payload, info.format, info.itemsize, shape));
+}
+
+/// Inverse of `pickle_buffer_reduce()`: requests a buffer from the (in-band or out-of-band)
+/// payload and restores the original format and shape. The returned `buffer_info` keeps the
+/// payload alive until it is destroyed, so it may be adopted instead of copied.
+inline buffer_info pickle_buffer_state(const tuple &state) {
+    if (state.size() != 4) {
+        throw value_error("py::pickle(): invalid buffer state");
+    }
+    auto info = state[0].cast<buffer>().request();
+    if (PyBuffer_IsContiguous(info.view(), 'C') == 0) {
+        throw value_error("py::pickle(): the pickled buffer must be C-contiguous");
+    }
+    auto shape = state[3].cast<tuple>();
+    info.format = state[1].cast<std::string>();
+    info.itemsize = state[2].cast<ssize_t>();
+    info.ndim = static_cast<ssize_t>(shape.size());
+    info.shape.clear();
+    info.size = 1;
+    for (auto dim : shape) {
+        info.shape.push_back(dim.cast<ssize_t>());
+        info.size *= info.shape.back();
+    }
+    if (info.itemsize <= 0 || info.size * info.itemsize != info.view()->len) {
+        throw value_error("py::pickle(): the pickled buffer size does not match its shape");
+    }
+    info.strides = c_strides(info.shape, info.itemsize);
+    return info;
+}
+
 /// Implementation for py::pickle(GetState, SetState)
 template <typename Get,
           typename Set,
@@ -512,6 +659,13 @@ struct pickle_factory<Get, Set, RetState(Self), NewInstance(ArgState)> {
 
     template <typename Class, typename... Extra>
     void execute(Class &cl, const Extra &...extra) && {
+        std::move(*this).execute_impl(
+            cl, std::is_same<intrinsic_t<RetState>, buffer_info>{}, extra...);
+    }
+
+private:
+    template <typename Class, typename... Extra>
+    void execute_impl(Class &cl, std::false_type /*buffer_state*/, const Extra &...extra) && {
         cl.def("__getstate__", std::move(get), pos_only());
 
 #if defined(PYBIND11_CPP14)
@@ -531,6 +685,44 @@ struct pickle_factory<Get, Set, RetState(Self), NewInstance(ArgState)> {
             is_new_style_constructor(),
             extra...);
     }
+
+    // `__getstate__` returns a `buffer_info`: bind `__reduce_ex__` instead, so that pickle
+    // protocol 5 can transfer the buffer out-of-band without copying it.
+    template <typename Class, typename... Extra>
+    void execute_impl(Class &cl, std::true_type /*buffer_state*/, const Extra &...extra) && {
+#if defined(PYBIND11_CPP14)
+        cl.def(
+            "__reduce_ex__",
+            [get_func = std::move(get)]
+#else
+        auto &get_func = get;
+        cl.def(
+            "__reduce_ex__",
+            [get_func]
+#endif
+            (const object &self, int protocol) {
+                const buffer_info &info = get_func(self.cast<Self>());
+                return pickle_buffer_reduce(self, info, protocol);
+            },
+            pos_only());
+
+#if defined(PYBIND11_CPP14)
+        cl.def(
+            "__setstate__",
+            [func = std::move(set)]
+#else
+        auto &func = set;
+        cl.def(
+            "__setstate__",
+            [func]
+#endif
+            (value_and_holder &v_h, const tuple &state) {
+                setstate<Class>(
+                    v_h, func(pickle_buffer_state(state)), Py_TYPE(v_h.inst) != v_h.type->type);
+            },
+            is_new_style_constructor(),
+            extra...);
+    }
 };
 
 PYBIND11_NAMESPACE_END(initimpl)
@@ -24,28 +24,7 @@
 #include <mutex>
 #include <thread>
 
-/// Tracks the `internals` and `type_info` ABI version independent of the main library version.
-///
-/// Some portions of the code use an ABI that is conditional depending on this
-/// version number.  That allows ABI-breaking changes to be "pre-implemented".
-/// Once the default version number is incremented, the conditional logic that
-/// no longer applies can be removed.  Additionally, users that need not
-/// maintain ABI compatibility can increase the version number in order to take
-/// advantage of any functionality/efficiency improvements that depend on the
-/// newer ABI.
-///
-/// WARNING: If you choose to manually increase the ABI version, note that
-/// pybind11 may not be tested as thoroughly with a non-default ABI version, and
-/// further ABI-incompatible changes may be made before the ABI is officially
-/// changed to the new version.
-#ifndef PYBIND11_INTERNALS_VERSION
-//   REMINDER for next version bump: remove loader_life_support_tls
-#    define PYBIND11_INTERNALS_VERSION 11
-#endif
-
-#if PYBIND11_INTERNALS_VERSION < 11
-#    error "PYBIND11_INTERNALS_VERSION 11 is the minimum for all platforms for pybind11v3."
-#endif
+// PYBIND11_INTERNALS_VERSION is defined in common.h (it also governs the `instance` layout).
 
 PYBIND11_NAMESPACE_BEGIN(PYBIND11_NAMESPACE)
 
@@ -295,6 +274,19 @@ struct internals {
     ~internals() = default;
 };
 
+// Bounded, direct-mapped cache of the `str` objects returned through `py::interned_str`, keyed
+// by a hash of the UTF-8 bytes (see `interned_str_from_utf8()`). The references held by the
+// cache are released by `py::clear_interned_str_cache()`, but intentionally not when the cache is
+// destroyed, which may happen after the interpreter is finalized.
+struct interned_str_cache {
+    static constexpr size_t num_slots = 1024; // Must be a power of two.
+    static constexpr size_t max_length = 64;  // Longer strings bypass the cache.
+    PyObject *slots[num_slots] = {};
+#ifdef Py_GIL_DISABLED
+    pymutex mutex;
+#endif
+};
+
 // the internals struct (above) is shared between all the modules. local_internals are only
 // for a single module. Any changes made to internals may require an update to
 // PYBIND11_INTERNALS_VERSION, breaking backwards compatibility. local_internals is, by design,
@@ -303,8 +295,11 @@ struct internals {
 // module that contains them.
 struct local_internals {
     type_map<type_info *> registered_types_cpp;
+    // Keyed by `std::type_info` address, see get_polymorphic_type_info().
+    std::unordered_map<const std::type_info *, type_info *> polymorphic_type_cache;
     std::forward_list<ExceptionTranslator> registered_exception_translators;
     PyTypeObject *function_record_py_type = nullptr;
+    interned_str_cache interned_strs;
 };
 
 enum class holder_enum_t : uint8_t {
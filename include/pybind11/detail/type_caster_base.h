@@ -107,6 +107,10 @@ public:
 inline std::pair<decltype(internals::registered_types_py)::iterator, bool>
 all_type_info_get_cache(PyTypeObject *type);
 
+// Returns the registered type for the given dynamic type of a polymorphic instance (or nullptr),
+// caching the result.
+inline type_info *get_polymorphic_type_info(const std::type_info &tp);
+
 // Band-aid workaround to fix a subtle but serious bug in a minimalistic fashion. See PR #4762.
 inline void all_type_info_add_base_most_derived_first(std::vector<type_info *> &bases,
                                                       type_info *addl_base) {
@@ -1523,7 +1527,7 @@ public:
             // except via a user-provided specialization of polymorphic_type_hook,
             // and the user has promised that no this-pointer adjustment is
             // required in that case, so it's OK to use static_cast.
-            if (const auto *tpi = get_type_info(*instance_type)) {
+            if (const auto *tpi = get_polymorphic_type_info(*instance_type)) {
                 return {vsrc, tpi};
             }
         }
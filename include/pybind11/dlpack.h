@@ -0,0 +1,466 @@
+/*
+    pybind11/dlpack.h: Zero-copy exchange of tensors through the DLPack protocol
+
+    Copyright (c) 2025 The Pybind Development Team.
+
+    All rights reserved. Use of this source code is governed by a
+    BSD-style license that can be found in the LICENSE file.
+*/
+
+#pragma once
+
+#include "pybind11.h"
+
+#include <complex>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+PYBIND11_NAMESPACE_BEGIN(PYBIND11_NAMESPACE)
+PYBIND11_NAMESPACE_BEGIN(detail)
+
+// The DLPack data structures (https://dmlc.github.io/dlpack/latest/c_api.html), declared here
+// so that pybind11 does not depend on dlpack.h. The names in comments are those of dlpack.h.
+
+// kDLCPU
+constexpr std::int32_t dlpack_device_cpu = 1;
+
+// DLDataTypeCode
+enum class dlpack_type_code : std::uint8_t {
+    int_ = 0,
+    uint = 1,
+    float_ = 2,
+    complex = 5,
+    bool_ = 6,
+};
+
+// DLPACK_FLAG_BITMASK_READ_ONLY
+constexpr std::uint64_t dlpack_flag_read_only = 1;
+
+// DLDevice
+struct dl_device {
+    std::int32_t device_type;
+    std::int32_t device_id;
+};
+
+// DLDataType
+struct dl_data_type {
+    std::uint8_t code;
+    std::uint8_t bits;
+    std::uint16_t lanes;
+};
+
+// DLTensor
+struct dl_tensor {
+    void *data;
+    dl_device device;
+    std::int32_t ndim;
+    dl_data_type dtype;
+    std::int64_t *shape;
+    std::int64_t *strides;
+    std::uint64_t byte_offset;
+};
+
+// DLManagedTensor, exchanged in capsules named "dltensor"
+struct dl_managed_tensor {
+    dl_tensor tensor;
+    void *manager_ctx;
+    void (*deleter)(dl_managed_tensor *self);
+};
+
+// DLPackVersion
+struct dl_pack_version {
+    std::uint32_t major;
+    std::uint32_t minor;
+};
+
+// DLManagedTensorVersioned, exchanged in capsules named "dltensor_versioned"
+struct dl_managed_tensor_versioned {
+    dl_pack_version version;
+    void *manager_ctx;
+    void (*deleter)(dl_managed_tensor_versioned *self);
+    std::uint64_t flags;
+    dl_tensor tensor;
+};
+
+// The DLPack type code of the element type T, if it has one.
+template <typename T, typename SFINAE = void>
+struct dlpack_type_code_of {};
+
+template <typename T>
+struct dlpack_type_code_of<T, enable_if_t<std::is_integral<T>::value>> {
+    static constexpr dlpack_type_code value
+        = std::is_same<T, bool>::value
+              ? dlpack_type_code::bool_
+              : (std::is_signed<T>::value ? dlpack_type_code::int_ : dlpack_type_code::uint);
+};
+
+template <typename T>
+struct dlpack_type_code_of<T, enable_if_t<std::is_floating_point<T>::value>> {
+    static constexpr dlpack_type_code value = dlpack_type_code::float_;
+};
+
+template <typename T>
+struct dlpack_type_code_of<std::complex<T>, enable_if_t<std::is_floating_point<T>::value>> {
+    static constexpr dlpack_type_code value = dlpack_type_code::complex;
+};
+
+template <typename T>
+dl_data_type dlpack_dtype() {
+    return {static_cast<std::uint8_t>(dlpack_type_code_of<T>::value),
+            static_cast<std::uint8_t>(8 * sizeof(T)),
+            1};
+}
+
+inline bool operator==(const dl_data_type &a, const dl_data_type &b) {
+    return a.code == b.code && a.bits == b.bits && a.lanes == b.lanes;
+}
+
+// An untyped view of a CPU tensor, with shape and strides in elements. `owner` keeps the data
+// alive.
+struct dlpack_view {
+    void *data = nullptr;
+    dl_data_type dtype{};
+    std::vector<ssize_t> shape;
+    std::vector<ssize_t> strides;
+    std::shared_ptr<void> owner;
+    bool readonly = false;
+};
+
+inline std::vector<ssize_t> c_strides(const std::vector<ssize_t> &shape) {
+    std::vector<ssize_t> strides(shape.size());
+    ssize_t stride = 1;
+    for (size_t i = shape.size(); i-- > 0;) {
+        strides[i] = stride;
+        stride *= shape[i];
+    }
+    return strides;
+}
+
+// Takes ownership of the DLPack tensor in the capsule returned by `src.__dlpack__()`, and views it
+// if it is on the CPU. Returns false if `src` does not support the protocol or the tensor is on
+// another device.
+inline bool dlpack_import(handle src, dlpack_view &view) {
+    if (!hasattr(src, "__dlpack__")) {
+        return false;
+    }
+    object capsule;
+    try {
+        if (hasattr(src, "__dlpack_device__")) {
+            object device = src.attr("__dlpack_device__")();
+            if (device[int_(0)].cast<int>() != dlpack_device_cpu) {
+                return false;
+            }
+        }
+        try {
+            capsule = src.attr("__dlpack__")(arg("max_version") = make_tuple(1, 0));
+        } catch (error_already_set &e) {
+            // Producers implementing DLPack < 1.0 do not accept `max_version`.
+            if (!e.matches(PyExc_TypeError)) {
+                throw;
+            }
+            capsule = src.attr("__dlpack__")();
+        }
+    } catch (const error_already_set &) {
+        return false;
+    } catch (const cast_error &) {
+        return false;
+    }
+
+    const dl_tensor *tensor = nullptr;
+    if (PyCapsule_IsValid(capsule.ptr(), "dltensor_versioned") != 0) {
+        auto *managed = static_cast<dl_managed_tensor_versioned *>(
+            PyCapsule_GetPointer(capsule.ptr(), "dltensor_versioned"));
+        if (managed->version.major != 1) {
+            return false; // Left to the capsule to delete.
+        }
+        if (PyCapsule_SetName(capsule.ptr(), "used_dltensor_versioned") != 0) {
+            throw error_already_set();
+        }
+        view.owner = std::shared_ptr<void>(managed, [](void *ptr) {
+            auto *self = static_cast<dl_managed_tensor_versioned *>(ptr);
+            if (self->deleter != nullptr) {
+                self->deleter(self);
+            }
+        });
+        view.readonly = (managed->flags & dlpack_flag_read_only) != 0;
+        tensor = &managed->tensor;
+    } else if (PyCapsule_IsValid(capsule.ptr(), "dltensor") != 0) {
+        auto *managed
+            = static_cast<dl_managed_tensor *>(PyCapsule_GetPointer(capsule.ptr(), "dltensor"));
+        if (PyCapsule_SetName(capsule.ptr(), "used_dltensor") != 0) {
+            throw error_already_set();
+        }
+        view.owner = std::shared_ptr<void>(managed, [](void *ptr) {
+            auto *self = static_cast<dl_managed_tensor *>(ptr);
+            if (self->deleter != nullptr) {
+                self->deleter(self);
+            }
+        });
+        tensor = &managed->tensor;
+    } else {
+        return false;
+    }
+
+    if (tensor->device.device_type != dlpack_device_cpu) {
+        return false;
+    }
+    view.data = static_cast<char *>(tensor->data) + tensor->byte_offset;
+    view.dtype = tensor->dtype;
+    view.shape.assign(tensor->shape, tensor->shape + tensor->ndim);
+    if (tensor->strides != nullptr) {
+        view.strides.assign(tensor->strides, tensor->strides + tensor->ndim);
+    } else {
+        view.strides = c_strides(view.shape);
+    }
+    return true;
+}
+
+// Name of the capsules holding a `Managed` tensor.
+template <typename Managed>
+struct dlpack_capsule_name;
+
+template <>
+struct dlpack_capsule_name<dl_managed_tensor_versioned> {
+    static const char *get() { return "dltensor_versioned"; }
+};
+
+template <>
+struct dlpack_capsule_name<dl_managed_tensor> {
+    static const char *get() { return "dltensor"; }
+};
+
+// Manager context of an exported tensor: owns the shape and strides arrays, and shares the
+// ownership of the data.
+template <typename Managed>
+struct dlpack_export_context {
+    Managed managed{};
+    std::vector<std::int64_t> shape;
+    std::vector<std::int64_t> strides;
+    std::shared_ptr<void> owner;
+
+    static void deleter(Managed *self) {
+        delete static_cast<dlpack_export_context *>(self->manager_ctx);
+    }
+
+    // Destructor of the capsule: deletes the tensor unless a consumer took ownership of it, and
+    // renamed the capsule to "used_dltensor[_versioned]".
+    static void capsule_destructor(PyObject *capsule) {
+        const char *name = dlpack_capsule_name<Managed>::get();
+        if (PyCapsule_IsValid(capsule, name) != 0) {
+            auto *self = static_cast<Managed *>(PyCapsule_GetPointer(capsule, name));
+            self->deleter(self);
+        }
+    }
+};
+
+// The Python object returned for a `dlpack_tensor`, implementing `__dlpack__` and
+// `__dlpack_device__`.
+struct dlpack_exporter {
+    dlpack_view view;
+
+    object dlpack(const object &stream,
+                  const object &max_version,
+                  const object &dl_device,
+                  const object &copy) const {
+        if (!stream.is_none()) {
+            throw buffer_error("stream must be None for a CPU tensor");
+        }
+        if (!dl_device.is_none()
+            && (dl_device[int_(0)].cast<int>() != dlpack_device_cpu
+                || dl_device[int_(1)].cast<int>() != 0)) {
+            throw buffer_error("the tensor can only be exported to the CPU");
+        }
+        if (!copy.is_none() && copy.cast<bool>()) {
+            throw buffer_error("copy=True is not supported");
+        }
+        if (!max_version.is_none() && max_version[int_(0)].cast<int>() >= 1) {
+            return make_capsule<dl_managed_tensor_versioned>();
+        }
+        if (view.readonly) {
+            throw buffer_error("a read-only tensor can only be exported with max_version >= 1");
+        }
+        return make_capsule<dl_managed_tensor>();
+    }
+
+private:
+    static void set_version(dl_managed_tensor_versioned &managed, bool readonly) {
+        managed.version = {1, 0};
+        managed.flags = readonly ? dlpack_flag_read_only : 0;
+    }
+    static void set_version(dl_managed_tensor &, bool) {}
+
+    template <typename Managed>
+    object make_capsule() const {
+        using context_t = dlpack_export_context<Managed>;
+        std::unique_ptr<context_t> context(new context_t());
+        context->shape.assign(view.shape.begin(), view.shape.end());
+        context->strides.assign(view.strides.begin(), view.strides.end());
+        context->owner = view.owner;
+
+        Managed &managed = context->managed;
+        set_version(managed, view.readonly);
+        managed.manager_ctx = context.get();
+        managed.deleter = &context_t::deleter;
+        managed.tensor.data = view.data;
+        managed.tensor.device = {dlpack_device_cpu, 0};
+        managed.tensor.ndim = static_cast<std::int32_t>(view.shape.size());
+        managed.tensor.dtype = view.dtype;
+        managed.tensor.shape = context->shape.data();
+        managed.tensor.strides = context->strides.data();
+        managed.tensor.byte_offset = 0;
+
+        PyObject *capsule = PyCapsule_New(
+            &managed, dlpack_capsule_name<Managed>::get(), &context_t::capsule_destructor);
+        if (capsule == nullptr) {
+            throw error_already_set();
+        }
+        context.release();
+        return reinterpret_steal<object>(capsule);
+    }
+};
+
+inline object dlpack_export(dlpack_view view) {
+    if (!get_type_info(typeid(dlpack_exporter), false)) {
+        class_<dlpack_exporter>(handle(), "dlpack_tensor", pybind11::module_local())
+            .def("__dlpack__",
+                 &dlpack_exporter::dlpack,
+                 pybind11::kw_only(),
+                 arg("stream") = none(),
+                 arg("max_version") = none(),
+                 arg("dl_device") = none(),
+                 arg("copy") = none())
+            .def("__dlpack_device__",
+                 [](const dlpack_exporter &) { return make_tuple(dlpack_device_cpu, 0); });
+    }
+    return cast(dlpack_exporter{std::move(view)});
+}
+
+PYBIND11_NAMESPACE_END(detail)
+
+/** \rst
+    A typed view of a tensor exchanged through the DLPack protocol (``__dlpack__``), such as a
+    NumPy array, a PyTorch or JAX tensor, or a CuPy array in host memory. Only CPU tensors are
+    supported. Shape and strides are in elements.
+
+    As a function argument, any object implementing ``__dlpack__`` with elements of type ``T``
+    is accepted without copying; ``T`` must be ``const`` to accept read-only tensors. Returned to
+    Python, a ``dlpack_tensor`` becomes an object implementing ``__dlpack__``, which can be passed
+    to ``numpy.from_dlpack()``, ``torch.from_dlpack()``, etc.
+\endrst */
+template <typename T>
+class dlpack_tensor {
+    using element_type = typename std::remove_const<T>::type;
+
+public:
+    dlpack_tensor() = default;
+
+    /// Views ``data``, kept alive by ``owner``. If ``strides`` is empty, the tensor is
+    /// C-contiguous.
+    dlpack_tensor(T *data,
+                  std::vector<ssize_t> shape,
+                  std::vector<ssize_t> strides = {},
+                  std::shared_ptr<void> owner = nullptr)
+        : m_data(data), m_shape(std::move(shape)), m_strides(std::move(strides)),
+          m_owner(std::move(owner)) {
+        if (m_strides.empty()) {
+            m_strides = detail::c_strides(m_shape);
+        }
+        if (m_strides.size() != m_shape.size()) {
+            pybind11_fail("dlpack_tensor: shape and strides must have the same length");
+        }
+    }
+
+    /// Takes ownership of ``values``, viewed as a C-contiguous tensor of the given shape (1-d by
+    /// default).
+    explicit dlpack_tensor(std::vector<element_type> &&values, std::vector<ssize_t> shape = {}) {
+        auto storage = std::make_shared<std::vector<element_type>>(std::move(values));
+        if (shape.empty()) {
+            shape.push_back(static_cast<ssize_t>(storage->size()));
+        }
+        ssize_t size = 1;
+        for (auto extent : shape) {
+            size *= extent;
+        }
+        if (size != static_cast<ssize_t>(storage->size())) {
+            pybind11_fail("dlpack_tensor: the shape does not match the number of values");
+        }
+        *this = dlpack_tensor(storage->data(), std::move(shape), {}, storage);
+    }
+
+    T *data() const { return m_data; }
+    ssize_t ndim() const { return static_cast<ssize_t>(m_shape.size()); }
+    const std::vector<ssize_t> &shape() const { return m_shape; }
+    ssize_t shape(ssize_t dim) const { return m_shape[static_cast<size_t>(dim)]; }
+    const std::vector<ssize_t> &strides() const { return m_strides; }
+    ssize_t strides(ssize_t dim) const { return m_strides[static_cast<size_t>(dim)]; }
+
+    /// Total number of elements.
+    ssize_t size() const {
+        ssize_t size = 1;
+        for (auto extent : m_shape) {
+            size *= extent;
+        }
+        return size;
+    }
+
+    /// The object keeping the data alive.
+    const std::shared_ptr<void> &owner() const { return m_owner; }
+
+    /// Element at the given indices, one per dimension. Bounds are not checked.
+    template <typename... Ix>
+    T &operator()(Ix... index) const {
+        const ssize_t indices[] = {0, static_cast<ssize_t>(index)...};
+        ssize_t offset = 0;
+        for (size_t i = 0; i < sizeof...(Ix); ++i) {
+            offset += indices[i + 1] * m_strides[i];
+        }
+        return m_data[offset];
+    }
+
+private:
+    T *m_data = nullptr;
+    std::vector<ssize_t> m_shape;
+    std::vector<ssize_t> m_strides;
+    std::shared_ptr<void> m_owner;
+};
+
+PYBIND11_NAMESPACE_BEGIN(detail)
+
+template <typename T>
+struct type_caster<dlpack_tensor<T>> {
+    using element_type = typename std::remove_const<T>::type;
+
+public:
+    PYBIND11_TYPE_CASTER(dlpack_tensor<T>, const_name("typing.Any"));
+
+    bool load(handle src, bool) {
+        dlpack_view view;
+        if (!dlpack_import(src, view) || !(view.dtype == dlpack_dtype<element_type>())
+            || (view.readonly && !std::is_const<T>::value)) {
+            return false;
+        }
+        value = dlpack_tensor<T>(static_cast<T *>(view.data),
+                                 std::move(view.shape),
+                                 std::move(view.strides),
+                                 std::move(view.owner));
+        return true;
+    }
+
+    static handle cast(const dlpack_tensor<T> &src, return_value_policy, handle) {
+        dlpack_view view;
+        view.data = const_cast<element_type *>(src.data());
+        view.dtype = dlpack_dtype<element_type>();
+        view.shape = src.shape();
+        view.strides = src.strides();
+        view.owner = src.owner();
+        view.readonly = std::is_const<T>::value;
+        return dlpack_export(std::move(view)).release();
+    }
+};
+
+PYBIND11_NAMESPACE_END(detail)
+PYBIND11_NAMESPACE_END(PYBIND11_NAMESPACE)
@@ -20,15 +20,26 @@
 #include <cstdint>
 #include <cstdlib>
 #include <cstring>
+#include <exception>
 #include <functional>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <new>
 #include <numeric>
 #include <sstream>
 #include <string>
+#include <system_error>
+#include <thread>
 #include <type_traits>
 #include <typeindex>
 #include <utility>
 #include <vector>
 
+#if defined(__linux__)
+#    include <sys/mman.h>
+#endif
+
 #if defined(PYBIND11_NUMPY_1_ONLY)
 #    error "PYBIND11_NUMPY_1_ONLY is no longer supported (see PR #5595)."
 #endif
@@ -382,6 +393,112 @@ private:
     }
 };
 
+// Layout of the leading fields of NumPy's `PyUFuncObject`, unchanged since NumPy 1.7.
+struct PyUFuncObject_Proxy {
+    PyObject_HEAD
+    int nin, nout, nargs;
+    int identity;
+    void *functions;
+    void *const *data;
+    int ntypes;
+    int reserved1;
+    const char *name;
+    const char *types;
+    const char *doc;
+    void *ptr;
+    PyObject *obj;
+};
+
+// Signature of the 1-d inner loops of a ufunc (`PyUFuncGenericFunction`).
+using ufunc_loop_func = void (*)(char **, const Py_intptr_t *, const Py_intptr_t *, void *);
+
+// Functions of NumPy's ufunc C API (the `_UFUNC_API` table), see `npy_api` for the array API.
+struct npy_ufunc_api {
+    enum constants {
+        PyUFunc_Zero_ = 0,
+        PyUFunc_One_ = 1,
+        PyUFunc_MinusOne_ = 2,
+        PyUFunc_None_ = -1,
+        PyUFunc_ReorderableNone_ = -2,
+    };
+
+    static npy_ufunc_api &get() {
+        PYBIND11_CONSTINIT static gil_safe_call_once_and_store<npy_ufunc_api> storage;
+        return storage.call_once_and_store_result(lookup).get_stored();
+    }
+
+    PyObject *(*PyUFunc_FromFuncAndData_)(ufunc_loop_func *,
+                                          void *const *,
+                                          const char *,
+                                          int,
+                                          int,
+                                          int,
+                                          int,
+                                          const char *,
+                                          const char *,
+                                          int);
+
+private:
+    enum functions { API_PyUFunc_FromFuncAndData = 1 };
+
+    static npy_ufunc_api lookup() {
+        module_ m = detail::import_numpy_core_submodule("_multiarray_umath");
+        auto c = m.attr("_UFUNC_API");
+        void **api_ptr = (void **) PyCapsule_GetPointer(c.ptr(), nullptr);
+        if (api_ptr == nullptr) {
+            raise_from(PyExc_SystemError, "FAILURE obtaining numpy _UFUNC_API pointer.");
+            throw error_already_set();
+        }
+        npy_ufunc_api api;
+#define DECL_NPY_UFUNC_API(Func) api.Func##_ = (decltype(api.Func##_)) api_ptr[API_##Func];
+        DECL_NPY_UFUNC_API(PyUFunc_FromFuncAndData);
+#undef DECL_NPY_UFUNC_API
+        return api;
+    }
+};
+
+// NumPy's array data memory handler functions (NumPy >= 1.22), see `npy_api`. The functions are
+// null with older versions of NumPy.
+struct npy_mem_handler_api {
+    static npy_mem_handler_api &get() {
+        PYBIND11_CONSTINIT static gil_safe_call_once_and_store<npy_mem_handler_api> storage;
+        return storage.call_once_and_store_result(lookup).get_stored();
+    }
+
+    PyObject *(*PyDataMem_SetHandler_)(PyObject *) = nullptr;
+
+private:
+    enum functions { API_PyDataMem_SetHandler = 304 };
+
+    static npy_mem_handler_api lookup() {
+        npy_mem_handler_api api;
+        if (npy_api::get().PyArray_RUNTIME_VERSION_ < 0xf) {
+            return api;
+        }
+        module_ m = detail::import_numpy_core_submodule("multiarray");
+        auto c = m.attr("_ARRAY_API");
+        void **api_ptr = (void **) PyCapsule_GetPointer(c.ptr(), nullptr);
+        if (api_ptr == nullptr) {
+            raise_from(PyExc_SystemError, "FAILURE obtaining numpy _ARRAY_API pointer.");
+            throw error_already_set();
+        }
+        api.PyDataMem_SetHandler_
+            = (decltype(api.PyDataMem_SetHandler_)) api_ptr[API_PyDataMem_SetHandler];
+        return api;
+    }
+};
+
+// PyDataMem_Handler (version 1), exchanged in capsules named "mem_handler".
+struct npy_mem_handler {
+    char name[127];
+    std::uint8_t version;
+    void *ctx;
+    void *(*malloc_)(void *ctx, size_t size);
+    void *(*calloc_)(void *ctx, size_t nelem, size_t elsize);
+    void *(*realloc_)(void *ctx, void *ptr, size_t new_size);
+    void (*free_)(void *ctx, void *ptr, size_t size);
+};
+
 template <typename T>
 struct is_complex : std::false_type {};
 template <typename T>
@@ -1355,6 +1472,265 @@ protected:
     }
 };
 
+/** \rst
+    Allocator policy for ``array_t(shape, allocator)``: allocates array data aligned to
+    ``alignment`` bytes (a power of two), e.g. 64 for AVX-512 loads and stores.
+\endrst */
+class aligned_allocator {
+public:
+    explicit aligned_allocator(size_t alignment = 64) : m_alignment(alignment) {
+        if (alignment < alignof(header) || (alignment & (alignment - 1)) != 0) {
+            throw value_error("aligned_allocator: the alignment must be a power of two, at least "
+                              + std::to_string(alignof(header)));
+        }
+    }
+
+    size_t alignment() const { return m_alignment; }
+
+    void *allocate(size_t bytes) const {
+        size_t total = bytes + m_alignment + sizeof(header);
+        void *raw = total > bytes ? std::malloc(total) : nullptr;
+        if (raw == nullptr) {
+            throw std::bad_alloc();
+        }
+        auto address = reinterpret_cast<std::uintptr_t>(raw) + sizeof(header);
+        address = (address + m_alignment - 1) & ~static_cast<std::uintptr_t>(m_alignment - 1);
+        auto *ptr = reinterpret_cast<void *>(address);
+        *header_of(ptr) = {raw, bytes};
+        return ptr;
+    }
+
+    void deallocate(void *ptr, size_t /*bytes*/) const noexcept {
+        if (ptr != nullptr) {
+            std::free(header_of(ptr)->raw);
+        }
+    }
+
+    /// Moves the data at ``ptr`` (if not null) into a new allocation of ``bytes`` bytes.
+    void *reallocate(void *ptr, size_t bytes) const {
+        void *result = allocate(bytes);
+        if (ptr != nullptr) {
+            std::memcpy(result, ptr, (std::min)(bytes, header_of(ptr)->bytes));
+            deallocate(ptr, 0);
+        }
+        return result;
+    }
+
+private:
+    // Stored right before each allocation.
+    struct header {
+        void *raw;
+        size_t bytes;
+    };
+
+    static header *header_of(void *ptr) { return static_cast<header *>(ptr) - 1; }
+
+    size_t m_alignment;
+};
+
+/** \rst
+    Allocator policy for ``array_t(shape, allocator)``: allocates array data aligned to 2 MiB
+    and, on Linux, advises the kernel to back it with transparent huge pages. This reduces TLB
+    misses when traversing large arrays, but wastes memory for small ones.
+\endrst */
+class huge_page_allocator : public aligned_allocator {
+public:
+    huge_page_allocator() : aligned_allocator(size_t{1} << 21) {}
+
+    void *allocate(size_t bytes) const { return advise(aligned_allocator::allocate(bytes), bytes); }
+
+    void *reallocate(void *ptr, size_t bytes) const {
+        return advise(aligned_allocator::reallocate(ptr, bytes), bytes);
+    }
+
+private:
+    static void *advise(void *ptr, size_t bytes) {
+#if defined(__linux__) && defined(MADV_HUGEPAGE)
+        // Only a hint: failures are ignored.
+        (void) madvise(ptr, bytes, MADV_HUGEPAGE);
+#else
+        (void) bytes;
+#endif
+        return ptr;
+    }
+};
+
+/** \rst
+    Allocator policy for ``array_t(shape, allocator)``: carves arrays out of large blocks of
+    memory, which are all released at once when the arena and every array allocated from it are
+    destroyed. Freeing a single array does not release any memory. Copies of an arena share the
+    same blocks.
+\endrst */
+class array_arena {
+public:
+    explicit array_arena(size_t block_size = size_t{1} << 20, size_t alignment = 64)
+        : m_state(std::make_shared<state>(block_size, aligned_allocator(alignment))) {}
+
+    void *allocate(size_t bytes) const {
+        state &s = *m_state;
+        std::lock_guard<std::mutex> lock(s.mutex);
+        size_t alignment = s.allocator.alignment();
+        size_t padded = (bytes + alignment - 1) & ~(alignment - 1);
+        if (padded < bytes) {
+            throw std::bad_alloc();
+        }
+        if (padded > s.remaining) {
+            size_t size = (std::max)(padded, s.block_size);
+            s.blocks.push_back(nullptr);
+            s.blocks.back() = s.allocator.allocate(size);
+            s.cursor = static_cast<char *>(s.blocks.back());
+            s.remaining = size;
+            s.reserved += size;
+        }
+        void *ptr = s.cursor;
+        s.cursor += padded;
+        s.remaining -= padded;
+        return ptr;
+    }
+
+    void deallocate(void *, size_t) const noexcept {}
+
+    /// Total size of the blocks allocated so far.
+    size_t bytes_reserved() const {
+        std::lock_guard<std::mutex> lock(m_state->mutex);
+        return m_state->reserved;
+    }
+
+private:
+    struct state {
+        state(size_t block_size_, aligned_allocator allocator_)
+            : block_size(block_size_), allocator(allocator_) {}
+        state(const state &) = delete;
+        state &operator=(const state &) = delete;
+        ~state() {
+            for (void *block : blocks) {
+                allocator.deallocate(block, 0);
+            }
+        }
+
+        std::mutex mutex;
+        size_t block_size;
+        aligned_allocator allocator;
+        std::vector<void *> blocks;
+        char *cursor = nullptr;
+        size_t remaining = 0;
+        size_t reserved = 0;
+    };
+
+    std::shared_ptr<state> m_state;
+};
+
+/** \rst
+    While this object is alive, routes the array data allocated by NumPy itself (e.g. by
+    ``numpy.empty()`` or for the result of ``a + b``) in the current thread or asyncio task to
+    an allocator policy, through ``PyDataMem_SetHandler()`` (NumPy >= 1.22). Besides
+    ``allocate()`` and ``deallocate()``, the allocator must implement ``reallocate()``, as
+    ``aligned_allocator`` and ``huge_page_allocator`` do. Each array keeps the allocator alive.
+\endrst */
+template <typename Allocator>
+class scoped_array_allocator {
+public:
+    explicit scoped_array_allocator(const Allocator &allocator,
+                                    const char *name = "pybind11_allocator") {
+        auto set_handler = detail::npy_mem_handler_api::get().PyDataMem_SetHandler_;
+        if (set_handler == nullptr) {
+            pybind11_fail("scoped_array_allocator requires NumPy >= 1.22");
+        }
+        std::unique_ptr<state> handler(new state(allocator));
+        std::strncpy(handler->handler.name, name, sizeof(handler->handler.name) - 1);
+        capsule c(&handler->handler, "mem_handler", [](void *ptr) {
+            delete static_cast<state *>(static_cast<detail::npy_mem_handler *>(ptr)->ctx);
+        });
+        handler.release();
+        m_previous = reinterpret_steal<object>(set_handler(c.ptr()));
+        if (!m_previous) {
+            throw error_already_set();
+        }
+    }
+
+    scoped_array_allocator(const scoped_array_allocator &) = delete;
+    scoped_array_allocator &operator=(const scoped_array_allocator &) = delete;
+
+    ~scoped_array_allocator() {
+        auto set_handler = detail::npy_mem_handler_api::get().PyDataMem_SetHandler_;
+        PyObject *handler = set_handler(m_previous.ptr());
+        if (handler == nullptr) {
+            error_already_set().discard_as_unraisable("~scoped_array_allocator");
+        }
+        Py_XDECREF(handler);
+    }
+
+private:
+    struct state {
+        explicit state(const Allocator &allocator_) : handler(), allocator(allocator_) {
+            handler.version = 1;
+            handler.ctx = this;
+            handler.malloc_ = &malloc_;
+            handler.calloc_ = &calloc_;
+            handler.realloc_ = &realloc_;
+            handler.free_ = &free_;
+        }
+
+        detail::npy_mem_handler handler;
+        Allocator allocator;
+    };
+
+    // The handler functions, which must not throw.
+    static void *malloc_(void *ctx, size_t size) {
+        try {
+            return static_cast<state *>(ctx)->allocator.allocate(size);
+        } catch (...) {
+            return nullptr;
+        }
+    }
+    static void *calloc_(void *ctx, size_t nelem, size_t elsize) {
+        if (elsize != 0 && nelem > (std::numeric_limits<size_t>::max)() / elsize) {
+            return nullptr;
+        }
+        void *ptr = malloc_(ctx, nelem * elsize);
+        if (ptr != nullptr) {
+            std::memset(ptr, 0, nelem * elsize);
+        }
+        return ptr;
+    }
+    static void *realloc_(void *ctx, void *ptr, size_t new_size) {
+        try {
+            return static_cast<state *>(ctx)->allocator.reallocate(ptr, new_size);
+        } catch (...) {
+            return nullptr;
+        }
+    }
+    static void free_(void *ctx, void *ptr, size_t size) {
+        static_cast<state *>(ctx)->allocator.deallocate(ptr, size);
+    }
+
+    object m_previous;
+};
+
+PYBIND11_NAMESPACE_BEGIN(detail)
+
+// Array data obtained from an allocator policy, owned by the capsule set as the array's base.
+template <typename Allocator>
+struct allocated_array_data {
+    Allocator allocator;
+    void *ptr;
+    size_t bytes;
+
+    allocated_array_data(const Allocator &allocator_, size_t bytes_)
+        : allocator(allocator_), ptr(allocator.allocate(bytes_)), bytes(bytes_) {}
+    allocated_array_data(const allocated_array_data &) = delete;
+    allocated_array_data &operator=(const allocated_array_data &) = delete;
+    ~allocated_array_data() { allocator.deallocate(ptr, bytes); }
+};
+
+template <typename Allocator>
+using allocator_pointer_t = decltype(std::declval<const Allocator &>().allocate(size_t{}));
+
+template <typename Allocator>
+using is_array_allocator = std::is_same<allocator_pointer_t<Allocator>, void *>;
+
+PYBIND11_NAMESPACE_END(detail)
+
 template <typename T, int ExtraFlags = array::forcecast>
 class array_t : public array {
 private:
@@ -1409,6 +1785,14 @@ public:
                   ptr,
                   base) {}
 
+    /// Allocates the (uninitialized) data with an allocator policy such as ``aligned_allocator``,
+    /// ``huge_page_allocator`` or ``array_arena``, instead of letting NumPy allocate it. A copy
+    /// of the allocator is kept by the array, to deallocate the data when the array is freed.
+    template <typename Allocator,
+              detail::enable_if_t<detail::is_array_allocator<Allocator>::value, int> = 0>
+    array_t(ShapeContainer shape, const Allocator &allocator)
+        : array_t(allocate_with(std::move(shape), allocator)) {}
+
     explicit array_t(ssize_t count, const T *ptr = nullptr, handle base = handle())
         : array({count}, {}, ptr, base) {}
 
@@ -1490,6 +1874,21 @@ public:
                && detail::check_flags(h.ptr(), ExtraFlags & (array::c_style | array::f_style));
     }
 
+protected:
+    template <typename Allocator>
+    static array_t allocate_with(ShapeContainer shape, const Allocator &allocator) {
+        using data_t = detail::allocated_array_data<Allocator>;
+        ssize_t size = 1;
+        for (auto extent : *shape) {
+            size *= extent;
+        }
+        std::unique_ptr<data_t> data(
+            new data_t(allocator, static_cast<size_t>(size) * sizeof(T)));
+        capsule base(data.get(), [](void *ptr) { delete static_cast<data_t *>(ptr); });
+        const auto *ptr = static_cast<const T *>(data.release()->ptr);
+        return array_t(std::move(shape), ptr, base);
+    }
+
 protected:
     /// Create array from any object -- always returns a new reference
     static PyObject *raw_array_t(PyObject *ptr) {
@@ -1507,6 +1906,79 @@ protected:
     }
 };
 
+PYBIND11_NAMESPACE_BEGIN(detail)
+
+// Checks that every element reached through `shape` and `strides` (in bytes) lies within a buffer
+// of `count` elements of `itemsize` bytes.
+inline void check_ndarray_extent(const std::vector<ssize_t> &shape,
+                                 const std::vector<ssize_t> &strides,
+                                 ssize_t itemsize,
+                                 size_t count) {
+    if (shape.size() != strides.size()) {
+        throw value_error("as_ndarray: shape and strides must have the same length");
+    }
+    ssize_t low = 0;
+    ssize_t high = 0;
+    for (size_t i = 0; i < shape.size(); ++i) {
+        if (shape[i] < 0) {
+            throw value_error("as_ndarray: negative dimensions are not allowed");
+        }
+        if (shape[i] == 0) {
+            return; // No element is reached.
+        }
+        ssize_t reach = (shape[i] - 1) * strides[i];
+        (reach < 0 ? low : high) += reach;
+    }
+    if (low < 0 || high + itemsize > static_cast<ssize_t>(count) * itemsize) {
+        throw value_error("as_ndarray: the shape and strides reach beyond the "
+                          + std::to_string(count) + " elements of the container");
+    }
+}
+
+PYBIND11_NAMESPACE_END(detail)
+
+/** \rst
+    Returns a NumPy array viewing the elements of ``values`` without copying them. The vector is
+    moved into a capsule set as the array's ``base``, and freed along with the array.
+
+    By default, the array is one-dimensional. ``shape`` and ``strides`` (in bytes, C-contiguous
+    by default) may describe any layout of the elements; ``value_error`` is raised if they reach
+    beyond the end of the vector.
+\endrst */
+template <typename T>
+array_t<T> as_ndarray(std::vector<T> &&values,
+                      array::ShapeContainer shape = {},
+                      array::StridesContainer strides = {}) {
+    static_assert(!std::is_same<T, bool>::value, "std::vector<bool> does not store bools");
+    if (shape->empty()) {
+        shape->push_back(static_cast<ssize_t>(values.size()));
+    }
+    if (strides->empty()) {
+        *strides = detail::c_strides(*shape, static_cast<ssize_t>(sizeof(T)));
+    }
+    detail::check_ndarray_extent(
+        *shape, *strides, static_cast<ssize_t>(sizeof(T)), values.size());
+    std::unique_ptr<std::vector<T>> container(new std::vector<T>(std::move(values)));
+    capsule base(container.get(),
+                 [](void *ptr) { delete static_cast<std::vector<T> *>(ptr); });
+    T *data = container.release()->data();
+    return array_t<T>(std::move(shape), std::move(strides), data, base);
+}
+
+/** \rst
+    Returns a NumPy array of the given shape viewing the elements of ``values`` without copying
+    them, and taking ownership of the array. The caller is responsible for ``shape`` and
+    ``strides`` (in bytes, C-contiguous by default) staying within the allocated elements.
+\endrst */
+template <typename T>
+array_t<T> as_ndarray(std::unique_ptr<T[]> &&values,
+                      array::ShapeContainer shape,
+                      array::StridesContainer strides = {}) {
+    capsule base(values.get(), [](void *ptr) { delete[] static_cast<T *>(ptr); });
+    T *data = values.release();
+    return array_t<T>(std::move(shape), std::move(strides), data, base);
+}
+
 template <typename T>
 struct format_descriptor<T, detail::enable_if_t<detail::is_pod_struct<T>::value>> {
     static std::string format() {
@@ -1881,27 +2353,47 @@ private:
     container_type m_strides;
 };
 
+// Iterates over the elements of a set of arrays broadcast to a common shape, in C order.
+// Adjacent dimensions that every array traverses with a uniform stride are coalesced, so the
+// innermost dimension forms runs that are as long as possible: with `inner_size()` and
+// `inner_stride<K>()`, callers can loop over a run with plain pointer arithmetic and then move on
+// to the next one with `next_run()`, like the external loop of NumPy's `nditer`.
 template <size_t N>
 class multi_array_iterator {
 public:
     using container_type = std::vector<ssize_t>;
 
     multi_array_iterator(const std::array<buffer_info, N> &buffers, const container_type &shape)
-        : m_shape(shape.size()), m_index(shape.size(), 0), m_common_iterator() {
+        : m_shape(shape), m_common_iterator() {
 
-        // Manual copy to avoid conversion warning if using std::copy
-        for (size_t i = 0; i < shape.size(); ++i) {
-            m_shape[i] = shape[i];
+        std::array<container_type, N> strides;
+        for (size_t i = 0; i < N; ++i) {
+            strides[i] = broadcast_strides(buffers[i], shape);
         }
+        coalesce(strides);
+        m_index.assign(m_shape.size(), 0);
 
-        container_type strides(shape.size());
+        // The common iterators only step over the outer dimensions: pointers within a run are
+        // computed from the inner strides.
+        auto outer_shape = m_shape;
+        outer_shape.back() = 1;
         for (size_t i = 0; i < N; ++i) {
-            init_common_iterator(buffers[i], shape, m_common_iterator[i], strides);
+            m_inner_strides[i] = strides[i].back();
+            m_common_iterator[i] = common_iter(buffers[i].ptr, strides[i], outer_shape);
         }
     }
 
     multi_array_iterator &operator++() {
-        for (size_t j = m_index.size(); j != 0; --j) {
+        if (++m_index.back() == m_shape.back()) {
+            next_run();
+        }
+        return *this;
+    }
+
+    // Moves to the first element of the next run along the innermost (coalesced) dimension.
+    multi_array_iterator &next_run() {
+        m_index.back() = 0;
+        for (size_t j = m_index.size() - 1; j != 0; --j) {
             size_t i = j - 1;
             if (++m_index[i] != m_shape[i]) {
                 increment_common_iterator(i);
@@ -1912,18 +2404,28 @@ public:
         return *this;
     }
 
+    // Number of elements in each run.
+    size_t inner_size() const { return static_cast<size_t>(m_shape.back()); }
+
+    // Byte stride of array K along a run (0 if it is broadcast along the run).
+    template <size_t K>
+    ssize_t inner_stride() const {
+        return m_inner_strides[K];
+    }
+
     template <size_t K, class T = void>
     T *data() const {
-        return reinterpret_cast<T *>(m_common_iterator[K].data());
+        auto *ptr = reinterpret_cast<char *>(m_common_iterator[K].data());
+        return reinterpret_cast<T *>(ptr + m_index.back() * m_inner_strides[K]);
     }
 
 private:
     using common_iter = common_iterator;
 
-    void init_common_iterator(const buffer_info &buffer,
-                              const container_type &shape,
-                              common_iter &iterator,
-                              container_type &strides) {
+    // Strides of `buffer` when broadcast to `shape`.
+    static container_type broadcast_strides(const buffer_info &buffer,
+                                            const container_type &shape) {
+        container_type strides(shape.size(), 0);
         auto buffer_shape_iter = buffer.shape.rbegin();
         auto buffer_strides_iter = buffer.strides.rbegin();
         auto shape_iter = shape.rbegin();
@@ -1932,8 +2434,6 @@ private:
         while (buffer_shape_iter != buffer.shape.rend()) {
             if (*shape_iter == *buffer_shape_iter) {
                 *strides_iter = *buffer_strides_iter;
-            } else {
-                *strides_iter = 0;
             }
 
             ++buffer_shape_iter;
@@ -1941,9 +2441,45 @@ private:
             ++shape_iter;
             ++strides_iter;
         }
+        return strides;
+    }
 
-        std::fill(strides_iter, strides.rend(), 0);
-        iterator = common_iter(buffer.ptr, strides, shape);
+    // Drops the dimensions of size 1, then merges each dimension into the next inner one when
+    // all arrays step over both with a single stride. At least one dimension is kept.
+    void coalesce(std::array<container_type, N> &strides) {
+        size_t ndim = 0;
+        for (size_t d = 0; d < m_shape.size(); ++d) {
+            if (m_shape[d] == 1) {
+                continue;
+            }
+            bool merge = ndim > 0;
+            for (size_t i = 0; i < N && merge; ++i) {
+                merge = strides[i][ndim - 1] == strides[i][d] * m_shape[d];
+            }
+            if (merge) {
+                m_shape[ndim - 1] *= m_shape[d];
+                for (auto &s : strides) {
+                    s[ndim - 1] = s[d];
+                }
+            } else {
+                m_shape[ndim] = m_shape[d];
+                for (auto &s : strides) {
+                    s[ndim] = s[d];
+                }
+                ++ndim;
+            }
+        }
+        if (ndim == 0) {
+            m_shape.assign(1, 1);
+            for (auto &s : strides) {
+                s.assign(1, 0);
+            }
+            return;
+        }
+        m_shape.resize(ndim);
+        for (auto &s : strides) {
+            s.resize(ndim);
+        }
     }
 
     void increment_common_iterator(size_t dim) {
@@ -1955,6 +2491,7 @@ private:
     container_type m_shape;
     container_type m_index;
     std::array<common_iter, N> m_common_iterator;
+    std::array<ssize_t, N> m_inner_strides{};
 };
 
 enum class broadcast_trivial { non_trivial, c_trivial, f_trivial };
@@ -2049,6 +2586,131 @@ broadcast(const std::array<buffer_info, N> &buffers, ssize_t &ndim, std::vector<
                                  : broadcast_trivial::non_trivial;
 }
 
+// View of a buffer restricted to the indices [begin, end) of the outermost of `ndim` broadcast
+// dimensions. Buffers broadcast along that dimension are viewed as a whole.
+inline buffer_info
+broadcast_outer_slice(const buffer_info &buffer, ssize_t ndim, size_t begin, size_t end) {
+    auto shape = buffer.shape;
+    void *ptr = buffer.ptr;
+    if (buffer.ndim == ndim && shape[0] != 1) {
+        ptr = static_cast<unsigned char *>(ptr) + static_cast<ssize_t>(begin) * buffer.strides[0];
+        shape[0] = static_cast<ssize_t>(end - begin);
+    }
+    return buffer_info(
+        ptr, buffer.itemsize, buffer.format, buffer.ndim, shape, buffer.strides, buffer.readonly);
+}
+
+PYBIND11_NAMESPACE_END(detail)
+
+/// Options to run a function wrapped with ``py::vectorize`` on multiple threads, with the GIL
+/// released. ``threads == 0`` uses one thread per hardware thread; no thread is started for less
+/// than ``min_chunk`` elements.
+struct parallel {
+    explicit parallel(size_t n_threads = 0, size_t min_chunk_size = 16384)
+        : threads(n_threads), min_chunk(min_chunk_size) {}
+
+    size_t threads;
+    size_t min_chunk;
+};
+
+PYBIND11_NAMESPACE_BEGIN(detail)
+
+// Number of chunks to split `size` elements into, made up of `units` indivisible units of work.
+inline size_t parallel_chunks(const parallel &options, size_t size, size_t units) {
+    size_t threads = options.threads;
+    if (threads == 0) {
+        threads = std::max<size_t>(std::thread::hardware_concurrency(), 1);
+    }
+    size_t by_size = size / std::max<size_t>(options.min_chunk, 1);
+    return std::max<size_t>(std::min(std::min(threads, by_size), units), 1);
+}
+
+// Calls `body(begin, end)` for `chunks` consecutive ranges of [0, units), each on its own thread
+// (one of them the calling thread), with the GIL released. Rethrows the first exception thrown
+// by `body` once all threads have finished. `body` must not use the Python C API.
+template <typename Body>
+void parallel_for(size_t chunks, size_t units, const Body &body) {
+    std::vector<std::exception_ptr> errors(chunks);
+    auto run_chunk = [&](size_t k) {
+        try {
+            body(units / chunks * k + std::min(k, units % chunks),
+                 units / chunks * (k + 1) + std::min(k + 1, units % chunks));
+        } catch (...) {
+            errors[k] = std::current_exception();
+        }
+    };
+    {
+        gil_scoped_release release;
+        std::vector<std::thread> threads;
+        threads.reserve(chunks);
+        for (size_t k = 1; k < chunks; ++k) {
+            try {
+                threads.emplace_back(run_chunk, k);
+            } catch (const std::system_error &) {
+                run_chunk(k); // Could not start another thread.
+            }
+        }
+        run_chunk(0);
+        for (auto &thread : threads) {
+            thread.join();
+        }
+    }
+    for (auto &error : errors) {
+        if (error) {
+            std::rethrow_exception(error);
+        }
+    }
+}
+
+// Range [first, last) of the addresses of the bytes of the elements of an array.
+inline std::pair<std::uintptr_t, std::uintptr_t> array_byte_range(
+    const void *ptr, ssize_t itemsize, ssize_t ndim, const ssize_t *shape, const ssize_t *strides) {
+    auto first = reinterpret_cast<std::uintptr_t>(ptr);
+    auto last = first + static_cast<std::uintptr_t>(itemsize);
+    for (ssize_t d = 0; d < ndim; ++d) {
+        if (shape[d] == 0) {
+            return {first, first};
+        }
+        ssize_t extent = (shape[d] - 1) * strides[d];
+        if (extent < 0) {
+            first -= static_cast<std::uintptr_t>(-extent);
+        } else {
+            last += static_cast<std::uintptr_t>(extent);
+        }
+    }
+    return {first, last};
+}
+
+// Whether the results of a vectorized function can be written directly into `out` (of the
+// result's shape and dtype) while iterating over the inputs: `out` must be contiguous in the order
+// of iteration, and must not overlap any input unless it is that very array, in which case each
+// element is read before it is overwritten.
+template <size_t N>
+bool vectorize_can_write_into(const array &out,
+                              broadcast_trivial trivial,
+                              const std::array<buffer_info, N> &buffers) {
+    auto contiguous = trivial == broadcast_trivial::f_trivial ? array::f_style : array::c_style;
+    if (!check_flags(out.ptr(), contiguous)) {
+        return false;
+    }
+    auto out_range
+        = array_byte_range(out.data(), out.itemsize(), out.ndim(), out.shape(), out.strides());
+    for (const auto &buffer : buffers) {
+        auto range = array_byte_range(
+            buffer.ptr, buffer.itemsize, buffer.ndim, buffer.shape.data(), buffer.strides.data());
+        if (range.first >= out_range.second || out_range.first >= range.second) {
+            continue;
+        }
+        bool same = buffer.ptr == out.data() && buffer.ndim == out.ndim()
+                    && std::equal(buffer.shape.begin(), buffer.shape.end(), out.shape())
+                    && std::equal(buffer.strides.begin(), buffer.strides.end(), out.strides());
+        if (!same) {
+            return false;
+        }
+    }
+    return true;
+}
+
 template <typename T>
 struct vectorize_arg {
     static_assert(!std::is_rvalue_reference<T>::value,
@@ -2081,6 +2743,31 @@ struct vectorize_returned_array {
         return array_t<Return>(shape);
     }
 
+    // Validates the `out` argument of a vectorized function. Returns `out` if the results can be
+    // written into it directly, or a new array for the results to be copied into `out` otherwise.
+    template <size_t N>
+    static Type create_for_out(handle out,
+                               broadcast_trivial trivial,
+                               const std::vector<ssize_t> &shape,
+                               const std::array<buffer_info, N> &buffers) {
+        if (!Type::check_(out)) {
+            throw type_error("out must be a numpy.ndarray with dtype "
+                             + std::string(str(dtype::of<Return>())));
+        }
+        auto out_array = reinterpret_borrow<Type>(out);
+        if (out_array.ndim() != static_cast<ssize_t>(shape.size())
+            || !std::equal(shape.begin(), shape.end(), out_array.shape())) {
+            throw value_error("out does not have the shape of the result");
+        }
+        if (!out_array.writeable()) {
+            throw value_error("out is read-only");
+        }
+        if (vectorize_can_write_into(out_array, trivial, buffers)) {
+            return out_array;
+        }
+        return create(trivial, shape);
+    }
+
     static Return *mutable_data(Type &array) { return array.mutable_data(); }
 
     static Return call(Func &f, Args &...args) { return f(args...); }
@@ -2095,6 +2782,14 @@ struct vectorize_returned_array<Func, void, Args...> {
 
     static Type create(broadcast_trivial, const std::vector<ssize_t> &) { return none(); }
 
+    template <size_t N>
+    static Type create_for_out(handle,
+                               broadcast_trivial,
+                               const std::vector<ssize_t> &,
+                               const std::array<buffer_info, N> &) {
+        return none();
+    }
+
     static void *mutable_data(Type &) { return nullptr; }
 
     static detail::void_type call(Func &f, Args &...args) {
@@ -2105,6 +2800,15 @@ struct vectorize_returned_array<Func, void, Args...> {
     static void call(void *, size_t, Func &f, Args &...args) { f(args...); }
 };
 
+template <typename Helper, typename... ArgTypes>
+struct vectorize_with_out {
+    Helper helper;
+
+    object operator()(ArgTypes... args, const object &out) {
+        return helper.call_with_out(out, args...);
+    }
+};
+
 template <typename Func, typename Return, typename... Args>
 struct vectorize_helper {
 
@@ -2128,15 +2832,43 @@ public:
                   !std::is_same<vectorize_helper, typename std::decay<T>::type>::value>>
     explicit vectorize_helper(T &&f) : f(std::forward<T>(f)) {}
 
+    template <typename T>
+    vectorize_helper(T &&f, const parallel &options)
+        : f(std::forward<T>(f)), parallel_options(options) {
+        static_assert(none_of<is_pyobject<Args>...>::value && !is_pyobject<Return>::value,
+                      "py::parallel() requires a function without Python object arguments or "
+                      "return value");
+    }
+
     object operator()(typename vectorize_arg<Args>::type... args) {
-        return run(args...,
+        return run(handle(),
+                   args...,
+                   make_index_sequence<N>(),
+                   select_indices<vectorize_arg<Args>::vectorize...>(),
+                   make_index_sequence<NVectorized>());
+    }
+
+    // Like `operator()`, but writes the results into the array `out` and returns it, unless
+    // `out` is None.
+    object call_with_out(handle out, typename vectorize_arg<Args>::type &...args) {
+        return run(out.is_none() ? handle() : out,
+                   args...,
                    make_index_sequence<N>(),
                    select_indices<vectorize_arg<Args>::vectorize...>(),
                    make_index_sequence<NVectorized>());
     }
 
+    /// Returns a callable that takes an additional, trailing ``out`` argument (see
+    /// ``call_with_out()``), like the ``out`` argument of a NumPy ufunc.
+    vectorize_with_out<vectorize_helper, typename vectorize_arg<Args>::type...> with_out() const {
+        static_assert(!std::is_void<Return>::value,
+                      "py::vectorize(...).with_out() requires a function with a return value");
+        return vectorize_with_out<vectorize_helper, typename vectorize_arg<Args>::type...>{*this};
+    }
+
 private:
     remove_reference_t<Func> f;
+    parallel parallel_options{1};
 
     // Internal compiler error in MSVC 19.16.27025.1 (Visual Studio 2017 15.9.4), when compiling
     // with "/permissive-" flag when arg_call_types is manually inlined.
@@ -2154,7 +2886,8 @@ private:
     //       we can store vectorized buffer_infos in an array (argument VIndex has its buffer at
     //       index BIndex in the array).
     template <size_t... Index, size_t... VIndex, size_t... BIndex>
-    object run(typename vectorize_arg<Args>::type &...args,
+    object run(handle out,
+               typename vectorize_arg<Args>::type &...args,
                index_sequence<Index...> i_seq,
                index_sequence<VIndex...> vi_seq,
                index_sequence<BIndex...> bi_seq) {
@@ -2179,13 +2912,14 @@ private:
 
         // If all arguments are 0-dimension arrays (i.e. single values) return a plain value (i.e.
         // not wrapped in an array).
-        if (size == 1 && ndim == 0) {
+        if (size == 1 && ndim == 0 && !out) {
             PYBIND11_EXPAND_SIDE_EFFECTS(params[VIndex] = buffers[BIndex].ptr);
             return cast(
                 returned_array::call(f, *reinterpret_cast<param_n_t<Index> *>(params[Index])...));
         }
 
-        auto result = returned_array::create(trivial, shape);
+        auto result = out ? returned_array::create_for_out(out, trivial, shape, buffers)
+                          : returned_array::create(trivial, shape);
 
         PYBIND11_WARNING_PUSH
 #ifdef PYBIND11_DETECTED_CLANG_WITH_MISLEADING_CALL_STD_MOVE_EXPLICITLY_WARNING
@@ -2193,26 +2927,64 @@ private:
 #endif
 
         if (size == 0) {
-            return result;
+            return out ? reinterpret_borrow<object>(out) : result;
         }
 
         /* Call the function */
         auto *mutable_data = returned_array::mutable_data(result);
         if (trivial == broadcast_trivial::non_trivial) {
-            apply_broadcast(buffers, params, mutable_data, size, shape, i_seq, vi_seq, bi_seq);
+            // Split the outermost dimension across threads.
+            auto outer = static_cast<size_t>(shape[0]);
+            size_t chunks = parallel_chunks(parallel_options, size, outer);
+            if (chunks == 1) {
+                apply_broadcast(
+                    buffers, params, mutable_data, 0, size, shape, i_seq, vi_seq, bi_seq);
+            } else {
+                parallel_for(chunks, outer, [&](size_t begin, size_t end) {
+                    auto chunk_shape = shape;
+                    chunk_shape[0] = static_cast<ssize_t>(end - begin);
+                    std::array<buffer_info, NVectorized> chunk_buffers{
+                        {broadcast_outer_slice(buffers[BIndex], nd, begin, end)...}};
+                    apply_broadcast(chunk_buffers,
+                                    params,
+                                    mutable_data,
+                                    begin * (size / outer),
+                                    (end - begin) * (size / outer),
+                                    chunk_shape,
+                                    i_seq,
+                                    vi_seq,
+                                    bi_seq);
+                });
+            }
         } else {
-            apply_trivial(buffers, params, mutable_data, size, i_seq, vi_seq, bi_seq);
+            size_t chunks = parallel_chunks(parallel_options, size, size);
+            if (chunks == 1) {
+                apply_trivial(buffers, params, mutable_data, 0, size, i_seq, vi_seq, bi_seq);
+            } else {
+                parallel_for(chunks, size, [&](size_t begin, size_t end) {
+                    apply_trivial(
+                        buffers, params, mutable_data, begin, end, i_seq, vi_seq, bi_seq);
+                });
+            }
         }
 
+        if (out && !result.is(out)) {
+            if (npy_api::get().PyArray_CopyInto_(out.ptr(), result.ptr()) < 0) {
+                throw error_already_set();
+            }
+            return reinterpret_borrow<object>(out);
+        }
         return result;
         PYBIND11_WARNING_POP
     }
 
+    // Calls the function for the output elements [begin, end).
     template <size_t... Index, size_t... VIndex, size_t... BIndex>
-    void apply_trivial(std::array<buffer_info, NVectorized> &buffers,
-                       std::array<void *, N> &params,
+    void apply_trivial(const std::array<buffer_info, NVectorized> &buffers,
+                       std::array<void *, N> params,
                        Return *out,
-                       size_t size,
+                       size_t begin,
+                       size_t end,
                        index_sequence<Index...>,
                        index_sequence<VIndex...>,
                        index_sequence<BIndex...>) {
@@ -2224,8 +2996,11 @@ private:
             {std::pair<unsigned char *&, const size_t>(
                 reinterpret_cast<unsigned char *&>(params[VIndex] = buffers[BIndex].ptr),
                 buffers[BIndex].size == 1 ? 0 : sizeof(param_n_t<VIndex>))...}};
+        for (auto &x : vecparams) {
+            x.first += begin * x.second;
+        }
 
-        for (size_t i = 0; i < size; ++i) {
+        for (size_t i = begin; i < end; ++i) {
             returned_array::call(
                 out, i, f, *reinterpret_cast<param_n_t<Index> *>(params[Index])...);
             for (auto &x : vecparams) {
@@ -2234,10 +3009,13 @@ private:
         }
     }
 
+    // Calls the function for `size` output elements (in C order), starting at `offset`, with
+    // `buffers` broadcast to `output_shape`.
     template <size_t... Index, size_t... VIndex, size_t... BIndex>
-    void apply_broadcast(std::array<buffer_info, NVectorized> &buffers,
-                         std::array<void *, N> &params,
+    void apply_broadcast(const std::array<buffer_info, NVectorized> &buffers,
+                         std::array<void *, N> params,
                          Return *out,
+                         size_t offset,
                          size_t size,
                          const std::vector<ssize_t> &output_shape,
                          index_sequence<Index...>,
@@ -2245,11 +3023,21 @@ private:
                          index_sequence<BIndex...>) {
 
         multi_array_iterator<NVectorized> input_iter(buffers, output_shape);
-
-        for (size_t i = 0; i < size; ++i, ++input_iter) {
-            PYBIND11_EXPAND_SIDE_EFFECTS((params[VIndex] = input_iter.template data<BIndex>()));
-            returned_array::call(
-                out, i, f, *reinterpret_cast<param_n_t<Index> *>(std::get<Index>(params))...);
+        size_t inner = input_iter.inner_size();
+        std::array<ssize_t, NVectorized> strides{{input_iter.template inner_stride<BIndex>()...}};
+
+        // A strided loop over each run of elements along the innermost coalesced dimension.
+        for (size_t i = 0; i < size; i += inner, input_iter.next_run()) {
+            std::array<char *, NVectorized> ptrs{{input_iter.template data<BIndex, char>()...}};
+            for (size_t j = 0; j < inner; ++j) {
+                PYBIND11_EXPAND_SIDE_EFFECTS((params[VIndex] = ptrs[BIndex]));
+                returned_array::call(
+                    out,
+                    offset + i + j,
+                    f,
+                    *reinterpret_cast<param_n_t<Index> *>(std::get<Index>(params))...);
+                PYBIND11_EXPAND_SIDE_EFFECTS(ptrs[BIndex] += strides[BIndex]);
+            }
         }
     }
 };
@@ -2259,6 +3047,187 @@ vectorize_helper<Func, Return, Args...> vectorize_extractor(const Func &f, Retur
     return detail::vectorize_helper<Func, Return, Args...>(f);
 }
 
+template <typename Func, typename Return, typename... Args>
+vectorize_helper<Func, Return, Args...>
+vectorize_extractor(const Func &f, Return (*)(Args...), const parallel &options) {
+    return detail::vectorize_helper<Func, Return, Args...>(f, options);
+}
+
+// Maximum number of elements passed to a `py::vectorize_block` kernel at once. This bounds the
+// scratch buffers that inputs without unit stride are gathered into.
+constexpr size_t vectorize_block_size = 1024;
+
+// Returns a pointer to `count` consecutive values of an input with the given byte stride:
+// the input itself if it is contiguous, or a copy of the values in `scratch` otherwise.
+// `broadcast_from` remembers the value a broadcast (zero stride) input was copied from, so that
+// the copy can be reused for the following blocks.
+template <typename T>
+const T *vectorize_block_input(const unsigned char *ptr,
+                               ssize_t stride,
+                               size_t count,
+                               std::vector<T> &scratch,
+                               const unsigned char *&broadcast_from) {
+    if (stride == static_cast<ssize_t>(sizeof(T))) {
+        return reinterpret_cast<const T *>(ptr);
+    }
+    if (stride == 0) {
+        if (ptr != broadcast_from || scratch.size() < count) {
+            scratch.assign(count, *reinterpret_cast<const T *>(ptr));
+            broadcast_from = ptr;
+        }
+    } else {
+        scratch.resize(count);
+        broadcast_from = nullptr;
+        for (size_t i = 0; i < count; ++i) {
+            scratch[i] = *reinterpret_cast<const T *>(ptr + static_cast<ssize_t>(i) * stride);
+        }
+    }
+    return scratch.data();
+}
+
+template <typename Func, typename Return, typename... Ins>
+struct vectorize_block_helper {
+    static constexpr size_t N = sizeof...(Ins);
+    static_assert(N >= 1, "pybind11::vectorize_block(...) requires a kernel with an input");
+
+    template <typename T,
+              // SFINAE to prevent shadowing the copy constructor.
+              typename = detail::enable_if_t<
+                  !std::is_same<vectorize_block_helper, typename std::decay<T>::type>::value>>
+    explicit vectorize_block_helper(T &&f) : f(std::forward<T>(f)) {}
+
+    object operator()(array_t<Ins, array::forcecast>... args) {
+        return run(args..., make_index_sequence<N>());
+    }
+
+private:
+    remove_reference_t<Func> f;
+
+    // Per-call buffers for the inputs without unit stride (see `vectorize_block_input()`).
+    struct block_scratch {
+        std::tuple<std::vector<Ins>...> values;
+        std::array<const unsigned char *, N> broadcast_from{};
+    };
+
+    template <size_t... I>
+    object run(array_t<Ins, array::forcecast> &...args, index_sequence<I...> i_seq) {
+        std::array<buffer_info, N> buffers{{args.request()...}};
+        block_scratch scratch;
+
+        ssize_t nd = 0;
+        std::vector<ssize_t> shape(0);
+        auto trivial = broadcast(buffers, nd, shape);
+        size_t size
+            = std::accumulate(shape.begin(), shape.end(), (size_t) 1, std::multiplies<size_t>());
+
+        // Byte strides of the inputs along the runs passed to the kernel.
+        std::array<ssize_t, N> strides{};
+        if (nd == 0) {
+            Return value{};
+            apply_run({{static_cast<const unsigned char *>(buffers[I].ptr)...}},
+                      strides,
+                      &value,
+                      1,
+                      scratch,
+                      i_seq);
+            return cast(value);
+        }
+
+        auto result = vectorize_returned_array<Func, Return, Ins...>::create(trivial, shape);
+        Return *out = result.mutable_data();
+        if (size == 0) {
+            return result;
+        }
+
+        if (trivial != broadcast_trivial::non_trivial) {
+            // A single run over all elements, in memory order.
+            for (size_t k = 0; k < N; ++k) {
+                strides[k] = buffers[k].size == 1 ? 0 : buffers[k].itemsize;
+            }
+            apply_run({{static_cast<const unsigned char *>(buffers[I].ptr)...}},
+                      strides,
+                      out,
+                      size,
+                      scratch,
+                      i_seq);
+            return result;
+        }
+
+        // One run along the innermost coalesced dimension for each index of the outer ones.
+        multi_array_iterator<N> iter(buffers, shape);
+        size_t inner = iter.inner_size();
+        strides = {{iter.template inner_stride<I>()...}};
+        for (size_t offset = 0; offset < size; offset += inner, iter.next_run()) {
+            apply_run({{iter.template data<I, const unsigned char>()...}},
+                      strides,
+                      out + offset,
+                      inner,
+                      scratch,
+                      i_seq);
+        }
+        return result;
+    }
+
+    // Calls the kernel on blocks of the `count` elements starting at `ptrs`.
+    template <size_t... I>
+    void apply_run(const std::array<const unsigned char *, N> &ptrs,
+                   const std::array<ssize_t, N> &strides,
+                   Return *out,
+                   size_t count,
+                   block_scratch &scratch,
+                   index_sequence<I...>) {
+        for (size_t done = 0; done < count; done += vectorize_block_size) {
+            size_t block = std::min(vectorize_block_size, count - done);
+            f(vectorize_block_input(ptrs[I] + static_cast<ssize_t>(done) * strides[I],
+                                    strides[I],
+                                    block,
+                                    std::get<I>(scratch.values),
+                                    scratch.broadcast_from[I])...,
+              out + done,
+              block);
+        }
+    }
+};
+
+// Splits the signature `void(const T1 *, ..., const TN *, Return *, size_t)` of a
+// `py::vectorize_block` kernel into its input and output types.
+template <typename Func, typename Signature, typename Indices>
+struct vectorize_block_signature;
+
+template <typename Func, typename... Args, size_t... I>
+struct vectorize_block_signature<Func, void(Args...), index_sequence<I...>> {
+    using arg_types = std::tuple<Args...>;
+    template <size_t K>
+    using arg_t = typename std::tuple_element<K, arg_types>::type;
+    template <size_t K>
+    using pointee_t = typename std::remove_pointer<arg_t<K>>::type;
+    static constexpr size_t NOut = sizeof...(Args) - 2;
+
+    static_assert(std::is_same<arg_t<NOut + 1>, size_t>::value
+                      && std::is_pointer<arg_t<NOut>>::value
+                      && !std::is_const<pointee_t<NOut>>::value
+                      && all_of<std::is_pointer<arg_t<I>>...>::value
+                      && all_of<std::is_const<pointee_t<I>>...>::value,
+                  "pybind11::vectorize_block(...) requires a kernel with the signature "
+                  "void(const T1 *, ..., const TN *, Return *, size_t)");
+
+    using type = vectorize_block_helper<Func, pointee_t<NOut>, remove_cv_t<pointee_t<I>>...>;
+};
+
+template <typename Func, typename Signature>
+struct vectorize_block_traits;
+
+template <typename Func, typename... Args>
+struct vectorize_block_traits<Func, void(Args...)>
+    : vectorize_block_signature<Func,
+                                void(Args...),
+                                make_index_sequence<(sizeof...(Args) > 2 ? sizeof...(Args) - 2
+                                                                         : 0)>> {
+    static_assert(sizeof...(Args) > 2,
+                  "pybind11::vectorize_block(...) requires a kernel with the signature "
+                  "void(const T1 *, ..., const TN *, Return *, size_t)");
+};
+
 template <typename T, int Flags>
 struct handle_type_name<array_t<T, Flags>> {
     static constexpr auto name
@@ -2274,6 +3243,13 @@ detail::vectorize_helper<Return (*)(Args...), Return, Args...> vectorize(Return
     return detail::vectorize_helper<Return (*)(Args...), Return, Args...>(f);
 }
 
+// Vanilla pointer vectorizer, running on multiple threads:
+template <typename Return, typename... Args>
+detail::vectorize_helper<Return (*)(Args...), Return, Args...>
+vectorize(Return (*f)(Args...), const parallel &options) {
+    return detail::vectorize_helper<Return (*)(Args...), Return, Args...>(f, options);
+}
+
 // lambda vectorizer:
 template <typename Func, detail::enable_if_t<detail::is_lambda<Func>::value, int> = 0>
 auto vectorize(Func &&f)
@@ -2283,6 +3259,15 @@ auto vectorize(Func &&f)
                                        (detail::function_signature_t<Func> *) nullptr);
 }
 
+// lambda vectorizer, running on multiple threads:
+template <typename Func, detail::enable_if_t<detail::is_lambda<Func>::value, int> = 0>
+auto vectorize(Func &&f, const parallel &options)
+    -> decltype(detail::vectorize_extractor(
+        std::forward<Func>(f), (detail::function_signature_t<Func> *) nullptr, options)) {
+    return detail::vectorize_extractor(
+        std::forward<Func>(f), (detail::function_signature_t<Func> *) nullptr, options);
+}
+
 // Vectorize a class method (non-const):
 template <typename Return,
           typename Class,
@@ -2296,6 +3281,19 @@ Helper vectorize(Return (Class::*f)(Args...)) {
     return Helper(std::mem_fn(f));
 }
 
+// Vectorize a class method (non-const), running on multiple threads:
+template <typename Return,
+          typename Class,
+          typename... Args,
+          typename Helper = detail::vectorize_helper<
+              decltype(std::mem_fn(std::declval<Return (Class::*)(Args...)>())),
+              Return,
+              Class *,
+              Args...>>
+Helper vectorize(Return (Class::*f)(Args...), const parallel &options) {
+    return Helper(std::mem_fn(f), options);
+}
+
 // Vectorize a class method (const):
 template <typename Return,
           typename Class,
@@ -2309,4 +3307,523 @@ Helper vectorize(Return (Class::*f)(Args...) const) {
     return Helper(std::mem_fn(f));
 }
 
+// Vectorize a class method (const), running on multiple threads:
+template <typename Return,
+          typename Class,
+          typename... Args,
+          typename Helper = detail::vectorize_helper<
+              decltype(std::mem_fn(std::declval<Return (Class::*)(Args...) const>())),
+              Return,
+              const Class *,
+              Args...>>
+Helper vectorize(Return (Class::*f)(Args...) const, const parallel &options) {
+    return Helper(std::mem_fn(f), options);
+}
+
+/** \rst
+    Vectorizes a kernel that processes a block of elements per call, such as a SIMD kernel, with
+    the signature ``void(const T1 *in1, ..., const TN *inN, Return *out, size_t n)``. The inputs
+    are broadcast like for ``py::vectorize``, and the kernel is called on consecutive runs of at
+    most 1024 elements, with all pointers pointing to ``n`` contiguous values.
+\endrst */
+template <typename Func,
+          typename Traits = detail::vectorize_block_traits<typename std::decay<Func>::type,
+                                                           detail::function_signature_t<Func>>>
+typename Traits::type vectorize_block(Func &&f) {
+    return typename Traits::type(std::forward<Func>(f));
+}
+
+PYBIND11_NAMESPACE_BEGIN(detail)
+
+// Default finalize step of `py::vectorize_reduce`: returns the accumulator.
+struct reduce_identity {
+    template <typename T>
+    T operator()(const T &value) const {
+        return value;
+    }
+};
+
+// The dimensions of an array of `ndim` dimensions selected by the `axis` argument of a reduction:
+// all of them for None, else those given by an integer or a sequence of integers (negative ones
+// counting from the end).
+inline std::vector<bool> reduction_axes(const object &axis, ssize_t ndim) {
+    std::vector<bool> reduced(static_cast<size_t>(ndim), axis.is_none());
+    auto add = [&](handle item) {
+        if (!PyIndex_Check(item.ptr())) {
+            throw type_error("axis must be None, an integer or a tuple of integers");
+        }
+        ssize_t a = PyNumber_AsSsize_t(item.ptr(), PyExc_OverflowError);
+        if (a == -1 && PyErr_Occurred()) {
+            throw error_already_set();
+        }
+        if (a < -ndim || a >= ndim) {
+            throw index_error("axis " + std::to_string(a)
+                              + " is out of bounds for array of dimension "
+                              + std::to_string(ndim));
+        }
+        auto dim = static_cast<size_t>(a < 0 ? a + ndim : a);
+        if (reduced[dim]) {
+            throw value_error("duplicate value in 'axis'");
+        }
+        reduced[dim] = true;
+    };
+    if (axis.is_none()) {
+        return reduced;
+    }
+    if (isinstance<sequence>(axis) && !isinstance<str>(axis)) {
+        for (auto item : axis) {
+            add(item);
+        }
+    } else {
+        add(axis);
+    }
+    return reduced;
+}
+
+// A dimension of a reduction: its extent, the byte stride of the input, the stride of the
+// accumulators (0 along the reduced axes) and the stride of the index passed to the combine step
+// (0 along the kept axes).
+struct reduction_dim {
+    ssize_t extent;
+    ssize_t in_stride;
+    ssize_t acc_stride;
+    ssize_t index_stride;
+};
+
+template <typename Acc, typename T, typename Combine, typename Finalize, bool WithIndex>
+struct vectorize_reduce_helper {
+    using Result = typename std::decay<decltype(std::declval<Finalize &>()(
+        std::declval<const Acc &>()))>::type;
+
+    template <typename C, typename F>
+    vectorize_reduce_helper(Acc init, C &&combine, F &&finalize, const parallel &options)
+        : init(std::move(init)), combine(std::forward<C>(combine)),
+          finalize(std::forward<F>(finalize)), parallel_options(options) {}
+
+    object operator()(const array_t<T, array::forcecast> &x, const object &axis, bool keepdims) {
+        auto ndim = x.ndim();
+        auto reduced = reduction_axes(axis, ndim);
+
+        // Accumulators in the C order of the kept axes, which is also the order of the result.
+        std::vector<ssize_t> out_shape;
+        std::vector<reduction_dim> dims;
+        ssize_t acc_size = 1;
+        ssize_t index_size = 1;
+        for (ssize_t d = ndim; d-- > 0;) {
+            auto extent = x.shape(d);
+            if (reduced[static_cast<size_t>(d)]) {
+                dims.push_back({extent, x.strides(d), 0, index_size});
+                index_size *= extent;
+            } else {
+                dims.push_back({extent, x.strides(d), acc_size, 0});
+                acc_size *= extent;
+            }
+        }
+        for (ssize_t d = 0; d < ndim; ++d) {
+            if (!reduced[static_cast<size_t>(d)]) {
+                out_shape.push_back(x.shape(d));
+            } else if (keepdims) {
+                out_shape.push_back(1);
+            }
+        }
+        std::reverse(dims.begin(), dims.end());
+        if (dims.empty()) {
+            dims.push_back({1, 0, 0, 0});
+        }
+
+        std::vector<acc_slot> acc(static_cast<size_t>(acc_size), acc_slot{init});
+        if (acc_size > 0 && index_size > 0) {
+            reduce(reinterpret_cast<const unsigned char *>(x.data()), dims, acc.data(), acc_size);
+        }
+
+        if (out_shape.empty() && !keepdims) {
+            return cast(finalize(acc[0].value));
+        }
+        array_t<Result> result(out_shape);
+        auto *out = result.mutable_data();
+        for (size_t i = 0; i < acc.size(); ++i) {
+            out[i] = finalize(acc[i].value);
+        }
+        return result;
+    }
+
+private:
+    Acc init;
+    remove_reference_t<Combine> combine;
+    remove_reference_t<Finalize> finalize;
+    parallel parallel_options;
+
+    // An accumulator. Wrapped so that the accumulators are not a `std::vector<bool>` (whose
+    // elements are packed bits) when `Acc` is `bool`, e.g. for any/all reductions.
+    struct acc_slot {
+        Acc value;
+    };
+
+    // Iterates in the order of decreasing input strides, so that the innermost loop runs over
+    // neighbouring elements whichever axes are reduced, and splits the largest kept axis across
+    // threads.
+    void reduce(const unsigned char *in,
+                std::vector<reduction_dim> dims,
+                acc_slot *acc,
+                ssize_t acc_size) {
+        std::stable_sort(
+            dims.begin(), dims.end(), [](const reduction_dim &a, const reduction_dim &b) {
+                return std::abs(a.in_stride) > std::abs(b.in_stride);
+            });
+        auto size = static_cast<size_t>(acc_size);
+        // Only a kept axis can be split: the threads must write to distinct accumulators.
+        size_t split = dims.size();
+        for (size_t d = 0; d < dims.size(); ++d) {
+            if (dims[d].acc_stride != 0
+                && (split == dims.size() || dims[d].extent > dims[split].extent)) {
+                split = d;
+            }
+            size *= dims[d].acc_stride == 0 ? static_cast<size_t>(dims[d].extent) : 1;
+        }
+        auto units = split != dims.size() ? static_cast<size_t>(dims[split].extent) : 1;
+        size_t chunks = parallel_chunks(parallel_options, size, units);
+        if (chunks == 1) {
+            reduce_range(in, dims, acc);
+            return;
+        }
+        parallel_for(chunks, units, [&](size_t begin, size_t end) {
+            auto chunk = dims;
+            chunk[split].extent = static_cast<ssize_t>(end - begin);
+            auto offset = static_cast<ssize_t>(begin);
+            reduce_range(in + offset * dims[split].in_stride,
+                         chunk,
+                         acc + offset * dims[split].acc_stride);
+        });
+    }
+
+    void
+    reduce_range(const unsigned char *in, const std::vector<reduction_dim> &dims, acc_slot *acc) {
+        size_t outer = dims.size() - 1;
+        std::vector<ssize_t> position(outer, 0);
+        ssize_t index = 0;
+        while (true) {
+            reduce_run(in, dims[outer], acc, index);
+            size_t d = outer;
+            for (; d > 0; --d) {
+                const auto &dim = dims[d - 1];
+                if (++position[d - 1] != dim.extent) {
+                    in += dim.in_stride;
+                    acc += dim.acc_stride;
+                    index += dim.index_stride;
+                    break;
+                }
+                position[d - 1] = 0;
+                in -= dim.in_stride * (dim.extent - 1);
+                acc -= dim.acc_stride * (dim.extent - 1);
+                index -= dim.index_stride * (dim.extent - 1);
+            }
+            if (d == 0) {
+                return;
+            }
+        }
+    }
+
+    void
+    reduce_run(const unsigned char *in, const reduction_dim &dim, acc_slot *acc, ssize_t index) {
+        if (dim.acc_stride == 0) {
+            // A run along a reduced axis: keep its accumulator in a local.
+            Acc value = acc->value;
+            for (ssize_t i = 0; i < dim.extent; ++i) {
+                value = call(
+                    std::move(value), in + i * dim.in_stride, index + i * dim.index_stride);
+            }
+            acc->value = std::move(value);
+            return;
+        }
+        for (ssize_t i = 0; i < dim.extent; ++i) {
+            Acc &value = acc[i * dim.acc_stride].value;
+            value = call(std::move(value), in + i * dim.in_stride, index);
+        }
+    }
+
+    Acc call(Acc &&value, const unsigned char *ptr, ssize_t index) {
+        return call(std::move(value), ptr, index, bool_constant<WithIndex>());
+    }
+    Acc call(Acc &&value, const unsigned char *ptr, ssize_t, std::false_type) {
+        return combine(std::move(value), *reinterpret_cast<const T *>(ptr));
+    }
+    Acc call(Acc &&value, const unsigned char *ptr, ssize_t index, std::true_type) {
+        return combine(std::move(value), *reinterpret_cast<const T *>(ptr), index);
+    }
+};
+
+// Deduces the element type of a `py::vectorize_reduce` combine step,
+// `Acc(Acc, T)` or `Acc(Acc, T, py::ssize_t index)`.
+template <typename Acc, typename Combine, typename Finalize, typename Signature>
+struct vectorize_reduce_traits {
+    static_assert(!std::is_same<Signature, Signature>::value,
+                  "py::vectorize_reduce(...) requires a combine step with the signature "
+                  "Acc(Acc, T) or Acc(Acc, T, py::ssize_t)");
+};
+
+template <typename Acc,
+          typename Combine,
+          typename Finalize,
+          typename Return,
+          typename A,
+          typename T>
+struct vectorize_reduce_traits<Acc, Combine, Finalize, Return(A, T)> {
+    using type = vectorize_reduce_helper<Acc, intrinsic_t<T>, Combine, Finalize, false>;
+};
+
+template <typename Acc,
+          typename Combine,
+          typename Finalize,
+          typename Return,
+          typename A,
+          typename T,
+          typename I>
+struct vectorize_reduce_traits<Acc, Combine, Finalize, Return(A, T, I)> {
+    using type = vectorize_reduce_helper<Acc, intrinsic_t<T>, Combine, Finalize, true>;
+};
+
+template <typename Acc, typename Combine, typename Finalize>
+using vectorize_reduce_t = typename vectorize_reduce_traits<
+    Acc,
+    typename std::decay<Combine>::type,
+    typename std::decay<Finalize>::type,
+    function_signature_t<typename std::decay<Combine>::type>>::type;
+
+PYBIND11_NAMESPACE_END(detail)
+
+/** \rst
+    Creates a reduction callable ``f(x, axis, keepdims)``, like ``numpy.sum``. For each element
+    of the result, an accumulator starting at ``init`` is updated with ``acc = combine(acc, x)``
+    (or ``combine(acc, x, index)``, where ``index`` is the flat index of ``x`` along the reduced
+    axes) for every element along the reduced axes. The result is ``finalize(acc)``.
+\endrst */
+template <typename Acc,
+          typename Combine,
+          typename Finalize = detail::reduce_identity,
+          detail::enable_if_t<
+              !std::is_same<typename std::decay<Finalize>::type, parallel>::value,
+              int> = 0>
+detail::vectorize_reduce_t<Acc, Combine, Finalize>
+vectorize_reduce(Acc init, Combine &&combine, Finalize &&finalize = Finalize()) {
+    return {std::move(init),
+            std::forward<Combine>(combine),
+            std::forward<Finalize>(finalize),
+            parallel(1)};
+}
+
+/// Like ``vectorize_reduce(init, combine, finalize)``, splitting the kept axes across threads.
+template <typename Acc, typename Combine, typename Finalize>
+detail::vectorize_reduce_t<Acc, Combine, Finalize> vectorize_reduce(Acc init,
+                                                                    Combine &&combine,
+                                                                    Finalize &&finalize,
+                                                                    const parallel &options) {
+    static_assert(!detail::is_pyobject<Acc>::value,
+                  "py::parallel() requires an accumulator that is not a Python object");
+    return {std::move(init), std::forward<Combine>(combine), std::forward<Finalize>(finalize),
+            options};
+}
+
+template <typename Acc, typename Combine>
+detail::vectorize_reduce_t<Acc, Combine, detail::reduce_identity>
+vectorize_reduce(Acc init, Combine &&combine, const parallel &options) {
+    static_assert(!detail::is_pyobject<Acc>::value,
+                  "py::parallel() requires an accumulator that is not a Python object");
+    return {std::move(init), std::forward<Combine>(combine), detail::reduce_identity(), options};
+}
+
+/// Identity of a ufunc, the initial value of its reductions (``ufunc.identity``).
+enum class ufunc_identity : int {
+    zero = detail::npy_ufunc_api::PyUFunc_Zero_,
+    one = detail::npy_ufunc_api::PyUFunc_One_,
+    minus_one = detail::npy_ufunc_api::PyUFunc_MinusOne_,
+    /// No identity: reductions of empty arrays raise, and reductions over several axes are
+    /// rejected as the operation is not assumed to be reorderable.
+    none = detail::npy_ufunc_api::PyUFunc_None_,
+    /// No identity, but reductions over several axes are allowed.
+    reorderable_none = detail::npy_ufunc_api::PyUFunc_ReorderableNone_,
+};
+
+PYBIND11_NAMESPACE_BEGIN(detail)
+
+// Inner loop of a ufunc calling `Func` on each element.
+template <typename Func, typename Return, typename... Args>
+struct ufunc_loop_impl {
+    static constexpr size_t N = sizeof...(Args);
+    static constexpr bool binary_op = N == 2 && all_of<std::is_same<Args, Return>...>::value;
+
+    static void call(char **args, const Py_intptr_t *dimensions, const Py_intptr_t *steps,
+                     void *data) {
+        auto &f = *static_cast<Func *>(data);
+        // Exceptions must not propagate into NumPy: they are raised as Python exceptions, which
+        // NumPy checks for after the loop, and the remaining elements are skipped.
+        try {
+            if (!reduce(f, args, dimensions[0], steps, bool_constant<binary_op>())) {
+                run(f, args, dimensions[0], steps, make_index_sequence<N>());
+            }
+        } catch (...) {
+            gil_scoped_acquire gil;
+            try_translate_exceptions();
+        }
+    }
+
+    template <size_t... I>
+    static void run(Func &f,
+                    char **args,
+                    Py_intptr_t n,
+                    const Py_intptr_t *steps,
+                    index_sequence<I...>) {
+        for (Py_intptr_t i = 0; i < n; ++i) {
+            *reinterpret_cast<Return *>(args[N] + i * steps[N])
+                = f(*reinterpret_cast<const Args *>(args[I] + i * steps[I])...);
+        }
+    }
+
+    static bool reduce(Func &, char **, Py_intptr_t, const Py_intptr_t *, std::false_type) {
+        return false;
+    }
+
+    // `ufunc.reduce` passes the accumulator as both the first input and the output, with zero
+    // strides: keep it in a local instead of storing and reloading it for every element.
+    static bool
+    reduce(Func &f, char **args, Py_intptr_t n, const Py_intptr_t *steps, std::true_type) {
+        if (args[0] != args[2] || steps[0] != 0 || steps[2] != 0) {
+            return false;
+        }
+        auto *acc = reinterpret_cast<Return *>(args[0]);
+        Return value = *acc;
+        for (Py_intptr_t i = 0; i < n; ++i) {
+            value = f(value, *reinterpret_cast<const Return *>(args[1] + i * steps[1]));
+        }
+        *acc = value;
+        return true;
+    }
+};
+
+// A typed inner loop of a ufunc, with the callable it applies.
+struct ufunc_loop {
+    ufunc_loop_func func;
+    std::shared_ptr<void> data;
+    std::vector<char> types;
+};
+
+// The arrays of loops, data and types passed to `PyUFunc_FromFuncAndData`, which NumPy does not
+// copy. They are owned by the ufunc object (through its `obj` field).
+struct ufunc_table {
+    std::string name;
+    std::string doc;
+    std::vector<ufunc_loop> loops;
+    std::vector<ufunc_loop_func> functions;
+    std::vector<void *> data;
+    std::vector<char> types;
+};
+
+template <typename Func, typename Signature>
+struct ufunc_loop_factory;
+
+template <typename Func, typename Return, typename... Args>
+struct ufunc_loop_factory<Func, Return(Args...)> {
+    static_assert(sizeof...(Args) > 0 && !std::is_void<Return>::value,
+                  "py::ufunc::def() requires a function with arguments and a return value");
+    static_assert(all_of<satisfies_any_of<intrinsic_t<Args>, std::is_arithmetic, is_complex>...,
+                         satisfies_any_of<Return, std::is_arithmetic, is_complex>>::value,
+                  "py::ufunc::def() only supports arithmetic and complex argument and return "
+                  "types");
+
+    template <typename F>
+    static ufunc_loop make(F &&f) {
+        ufunc_loop loop;
+        loop.func = &ufunc_loop_impl<Func, Return, intrinsic_t<Args>...>::call;
+        loop.data = std::make_shared<Func>(std::forward<F>(f));
+        loop.types = {static_cast<char>(dtype::of<intrinsic_t<Args>>().num())...,
+                      static_cast<char>(dtype::of<Return>().num())};
+        return loop;
+    }
+};
+
+PYBIND11_NAMESPACE_END(detail)
+
+/** \rst
+    Defines a genuine NumPy ufunc named ``name`` in the module (or other scope) ``scope``, with an
+    inner loop per C++ function added with ``def()``. NumPy selects the loop from the dtypes of the
+    arguments, casting them if needed, and provides ``reduce``, ``accumulate``, ``outer``, ``at``
+    and the ``out``, ``where`` and ``dtype`` arguments.
+
+    .. code-block:: cpp
+
+        py::ufunc(m, "add", "Adds two arrays", py::ufunc_identity::zero)
+            .def([](float a, float b) { return a + b; })
+            .def<double(double, double)>(std::plus<double>());
+\endrst */
+class ufunc : public object {
+public:
+    ufunc(handle scope,
+          const char *name,
+          const char *doc = "",
+          ufunc_identity identity = ufunc_identity::none)
+        : m_scope(reinterpret_borrow<object>(scope)), m_name(name), m_doc(doc),
+          m_identity(identity) {}
+
+    /// Adds an inner loop calling ``f`` on each element. The argument and return types, and hence
+    /// the dtypes of the loop, are those of ``Signature`` or, by default, of ``f`` itself. All
+    /// loops must have the same number of arguments.
+    template <typename Signature = void, typename Func>
+    ufunc &def(Func &&f) {
+        using func_type = typename std::decay<Func>::type;
+        using signature = detail::conditional_t<std::is_void<Signature>::value,
+                                                detail::function_signature_t<func_type>,
+                                                Signature>;
+        using factory = detail::ufunc_loop_factory<func_type, signature>;
+        auto loop = factory::make(std::forward<Func>(f));
+        if (!m_loops.empty() && loop.types.size() != m_loops.front().types.size()) {
+            pybind11_fail("py::ufunc::def(): all loops of ufunc \"" + m_name
+                          + "\" must have the same number of arguments");
+        }
+        m_loops.push_back(std::move(loop));
+        update();
+        return *this;
+    }
+
+private:
+    // NumPy ufuncs are immutable, so a new one is created with all loops defined so far.
+    void update() {
+        std::unique_ptr<detail::ufunc_table> table(new detail::ufunc_table());
+        table->name = m_name;
+        table->doc = m_doc;
+        table->loops = m_loops;
+        for (const auto &loop : table->loops) {
+            table->functions.push_back(loop.func);
+            table->data.push_back(loop.data.get());
+            table->types.insert(table->types.end(), loop.types.begin(), loop.types.end());
+        }
+        int nin = static_cast<int>(m_loops.front().types.size()) - 1;
+        auto &api = detail::npy_ufunc_api::get();
+        auto result = reinterpret_steal<object>(
+            api.PyUFunc_FromFuncAndData_(table->functions.data(),
+                                         table->data.data(),
+                                         table->types.data(),
+                                         static_cast<int>(table->loops.size()),
+                                         nin,
+                                         1,
+                                         static_cast<int>(m_identity),
+                                         table->name.c_str(),
+                                         table->doc.c_str(),
+                                         0));
+        if (!result) {
+            throw error_already_set();
+        }
+        capsule owner(table.get(),
+                      [](void *ptr) { delete static_cast<detail::ufunc_table *>(ptr); });
+        table.release();
+        reinterpret_cast<detail::PyUFuncObject_Proxy *>(result.ptr())->obj = owner.release().ptr();
+        m_scope.attr(m_name.c_str()) = result;
+        object::operator=(std::move(result));
+    }
+
+    object m_scope;
+    std::string m_name;
+    std::string m_doc;
+    ufunc_identity m_identity;
+    std::vector<detail::ufunc_loop> m_loops;
+};
+
 PYBIND11_NAMESPACE_END(PYBIND11_NAMESPACE)
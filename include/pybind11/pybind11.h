@@ -10,6 +10,7 @@
 
 #pragma once
 #include "detail/class.h"
+#include "detail/deferred_cpp_dtor_queue.h"
 #include "detail/dynamic_raw_ptr_cast_if_possible.h"
 #include "detail/exception_translation.h"
 #include "detail/function_record_pyobject.h"
@@ -2024,6 +2025,42 @@ struct property_cpp_function<
         detail::both_t_and_d_use_type_caster_base<T, typename D::element_type>>::value>>
     : detail::property_cpp_function_sh_unique_ptr_member<T, D> {};
 
+/// Blocks until all C++ destructor calls deferred for `py::deferred_cpp_dtor()` classes of this
+/// extension module have completed. This function does not release the GIL; when exposing it
+/// to Python, bind it with `py::call_guard<py::gil_scoped_release>()`.
+inline void flush_deferred_cpp_dtors() { detail::deferred_cpp_dtor_queue::get().flush(); }
+
+/// Number of deferred C++ destructor calls that are queued or in progress.
+inline size_t deferred_cpp_dtors_pending() {
+    return detail::deferred_cpp_dtor_queue::get().pending();
+}
+
+/// Sets the maximum number of queued deferred C++ destructor calls (default: 1024). When the
+/// queue is full, destructors run synchronously on the deallocating thread instead.
+inline void set_deferred_cpp_dtor_queue_capacity(size_t capacity) {
+    detail::deferred_cpp_dtor_queue::get().set_capacity(capacity);
+}
+
+PYBIND11_NAMESPACE_BEGIN(detail)
+// Drains the queue before the interpreter is finalized, and restarts the worker after fork().
+inline void register_deferred_cpp_dtor_hooks() {
+    PYBIND11_CONSTINIT static gil_safe_call_once_and_store<bool> storage;
+    storage.call_once_and_store_result([]() {
+        module_::import("atexit").attr("register")(
+            cpp_function(&flush_deferred_cpp_dtors, call_guard<gil_scoped_release>()));
+        auto os = module_::import("os");
+        if (hasattr(os, "register_at_fork")) {
+            auto *queue = &deferred_cpp_dtor_queue::get();
+            os.attr("register_at_fork")(
+                arg("before") = cpp_function([queue]() { queue->before_fork(); }),
+                arg("after_in_parent") = cpp_function([queue]() { queue->after_fork_parent(); }),
+                arg("after_in_child") = cpp_function([queue]() { queue->after_fork_child(); }));
+        }
+        return true;
+    });
+}
+PYBIND11_NAMESPACE_END(detail)
+
 #ifdef PYBIND11_RUN_TESTING_WITH_SMART_HOLDER_AS_DEFAULT_BUT_NEVER_USE_IN_PRODUCTION_PLEASE
 // NOTE: THIS IS MEANT FOR STRESS-TESTING OR TRIAGING ONLY!
 //       Running the pybind11 unit tests with smart_holder as the default holder is to ensure
@@ -2091,6 +2128,10 @@ public:
                  none_of<std::is_same<multiple_inheritance, Extra>...>::value),
             "Error: multiple inheritance bases must be specified via class_ template options");
 
+        static_assert(none_of<std::is_same<deferred_cpp_dtor, Extra>...>::value
+                          || std::is_move_constructible<holder_type>::value,
+                      "py::deferred_cpp_dtor() requires a move-constructible holder type");
+
         type_record record;
         record.scope = scope;
         record.name = name;
@@ -2118,7 +2159,10 @@ public:
         /* Process optional arguments, if any */
         process_attributes<Extra...>::init(extra..., &record);
 
-        if (record.release_gil_before_calling_cpp_dtor) {
+        if (record.deferred_cpp_dtor) {
+            record.dealloc = dealloc_deferred_cpp_dtor;
+            register_deferred_cpp_dtor_hooks();
+        } else if (record.release_gil_before_calling_cpp_dtor) {
             record.dealloc = dealloc_release_gil_before_calling_cpp_dtor;
         } else {
             record.dealloc = dealloc_without_manipulating_gil;
@@ -2208,6 +2252,14 @@ public:
         return *this;
     }
 
+    template <typename... Args, typename... Extra>
+    class_ &def(const detail::initimpl::shared_constructor<Args...> &init,
+                const Extra &...extra) {
+        PYBIND11_WORKAROUND_INCORRECT_MSVC_C4100(init);
+        init.execute(*this, extra...);
+        return *this;
+    }
+
     template <typename... Args, typename... Extra>
     class_ &def(detail::initimpl::factory<Args...> &&init, const Extra &...extra) {
         std::move(init).execute(*this, extra...);
@@ -2563,6 +2615,23 @@ private:
         PyEval_RestoreThread(py_ts);
     }
 
+    static void dealloc_deferred_cpp_dtor(detail::value_and_holder &v_h) {
+        error_scope scope;
+        if (!v_h.holder_constructed()) {
+            dealloc_impl(v_h);
+            return;
+        }
+        // Move the holder out of the instance; the C++ object is destroyed together with it.
+        auto *holder = new holder_type(std::move(v_h.holder<holder_type>()));
+        v_h.holder<holder_type>().~holder_type();
+        v_h.set_holder_constructed(false);
+        v_h.value_ptr() = nullptr;
+        auto destroy = [](void *ptr) { delete static_cast<holder_type *>(ptr); };
+        if (!detail::deferred_cpp_dtor_queue::get().push(destroy, holder)) {
+            destroy(holder);
+        }
+    }
+
     static detail::function_record *get_function_record(handle h) {
         h = detail::get_function(h);
         if (!h) {
@@ -2593,6 +2662,13 @@ template <typename... Args>
 detail::initimpl::alias_constructor<Args...> init_alias() {
     return {};
 }
+/// Like `init<Args...>()`, but constructs the instance with `std::make_shared`, so that the C++
+/// object and the `std::shared_ptr` control block share a single allocation. Requires a
+/// `py::smart_holder` or `std::shared_ptr` holder.
+template <typename... Args>
+detail::initimpl::shared_constructor<Args...> init_shared() {
+    return {};
+}
 
 /// Binds a factory function as a constructor
 template <typename Func, typename Ret = detail::initimpl::factory<Func>>
@@ -2610,6 +2686,8 @@ Ret init(CFunc &&c, AFunc &&a) {
 
 /// Binds pickling functions `__getstate__` and `__setstate__` and ensures that the type
 /// returned by `__getstate__` is the same as the argument accepted by `__setstate__`.
+/// If the state type is `buffer_info`, `__reduce_ex__` is bound instead of `__getstate__` and
+/// pickle protocol 5 transfers the (C-contiguous) buffer out-of-band as a `pickle.PickleBuffer`.
 template <typename GetState, typename SetState>
 detail::initimpl::pickle_factory<GetState, SetState> pickle(GetState &&g, SetState &&s) {
     return {std::forward<GetState>(g), std::forward<SetState>(s)};
@@ -3008,6 +3086,37 @@ all_type_info_get_cache(PyTypeObject *type) {
     return res;
 }
 
+// Polymorphic return values are cast to their most-derived registered type, which is otherwise
+// looked up by name in the registered types on every cast. The cache is keyed by the address of
+// the `std::type_info`; lookup failures are not cached, because the type may be registered later.
+inline type_info *get_polymorphic_type_info(const std::type_info &tp) {
+    auto &cache = get_local_internals().polymorphic_type_cache;
+    auto *tpi = with_internals([&](internals &) -> type_info * {
+        auto it = cache.find(&tp);
+        return it != cache.end() ? it->second : nullptr;
+    });
+    if (tpi) {
+        return tpi;
+    }
+    tpi = get_type_info(tp);
+    if (!tpi) {
+        return nullptr;
+    }
+    bool inserted = with_internals([&](internals &) { return cache.emplace(&tp, tpi).second; });
+    if (inserted) {
+        // Remove the entry when the type gets destroyed.
+        const auto *key = &tp;
+        weakref((PyObject *) tpi->type, cpp_function([key](handle wr) {
+                    with_internals([key](internals &) {
+                        get_local_internals().polymorphic_type_cache.erase(key);
+                    });
+                    wr.dec_ref();
+                }))
+            .release();
+    }
+    return tpi;
+}
+
 /* There are a large number of apparently unused template arguments because
  * each combination requires a separate py::class_ registration.
  */
@@ -3199,6 +3308,58 @@ typing::Iterator<ValueType> make_value_iterator(Type &value, Extra &&...extra) {
         std::begin(value), std::end(value), std::forward<Extra>(extra)...);
 }
 
+PYBIND11_NAMESPACE_BEGIN(detail)
+
+// Read-only bytes exported through the buffer protocol, keeping alive the C++ storage they
+// point into (see `owned_memoryview()`).
+struct owned_bytes {
+    std::shared_ptr<const void> storage;
+    const std::uint8_t *data;
+    ssize_t size;
+};
+
+inline memoryview
+make_owned_memoryview(std::shared_ptr<const void> storage, const void *data, size_t size) {
+    if (!get_type_info(typeid(owned_bytes), false)) {
+        class_<owned_bytes>(
+            handle(), "owned_bytes", pybind11::module_local(), pybind11::buffer_protocol())
+            .def_buffer([](const owned_bytes &b) { return buffer_info(b.data, b.size); });
+    }
+    static const std::uint8_t empty = 0;
+    auto owner = cast(owned_bytes{std::move(storage),
+                                  data != nullptr ? static_cast<const std::uint8_t *>(data)
+                                                  : &empty,
+                                  static_cast<ssize_t>(size)});
+    auto *view = PyMemoryView_FromObject(owner.ptr());
+    if (!view) {
+        throw error_already_set();
+    }
+    return reinterpret_steal<memoryview>(view);
+}
+
+PYBIND11_NAMESPACE_END(detail)
+
+/// Returns a read-only ``memoryview`` of the bytes of a string, without copying them. The
+/// string is moved into storage owned by the memoryview, and freed when it is released.
+inline memoryview owned_memoryview(std::string &&value) {
+    auto storage = std::make_shared<std::string>(std::move(value));
+    return detail::make_owned_memoryview(storage, storage->data(), storage->size());
+}
+
+/// Returns a read-only ``memoryview`` of the bytes of a vector, without copying them.
+inline memoryview owned_memoryview(std::vector<std::uint8_t> &&value) {
+    auto storage = std::make_shared<std::vector<std::uint8_t>>(std::move(value));
+    return detail::make_owned_memoryview(storage, storage->data(), storage->size());
+}
+
+/// Returns a read-only ``memoryview`` of the first ``size`` bytes of an array, without
+/// copying them. The memoryview takes ownership of the array.
+inline memoryview owned_memoryview(std::unique_ptr<std::uint8_t[]> &&value, size_t size) {
+    std::shared_ptr<const std::uint8_t> storage(value.release(),
+                                                std::default_delete<const std::uint8_t[]>());
+    return detail::make_owned_memoryview(storage, storage.get(), size);
+}
+
 template <typename InputType, typename OutputType>
 void implicitly_convertible() {
     static int tss_sentinel_pointee = 1; // arbitrary value
@@ -10,10 +10,12 @@
 #pragma once
 
 #include "pybind11.h"
+#include "critical_section.h"
 #include "detail/common.h"
 #include "detail/descr.h"
 #include "detail/type_caster_base.h"
 
+#include <cstdint>
 #include <deque>
 #include <initializer_list>
 #include <list>
@@ -36,6 +38,10 @@
 #    include <variant>
 #endif
 
+#if defined(PYBIND11_HAS_SPAN)
+#    include <span>
+#endif
+
 PYBIND11_NAMESPACE_BEGIN(PYBIND11_NAMESPACE)
 PYBIND11_NAMESPACE_BEGIN(detail)
 
@@ -222,6 +228,21 @@ public:
                              + const_name("]"));
 };
 
+// Returns an empty `dict` with room for `size` items, so that filling it does not resize it
+// repeatedly. The size is only a hint where CPython does not expose `_PyDict_NewPresized()`.
+inline dict new_presized_dict(size_t size) {
+#if PY_VERSION_HEX < 0x030D0000 && !defined(PYPY_VERSION) && !defined(GRAALVM_PYTHON)
+    auto d = reinterpret_steal<dict>(_PyDict_NewPresized(static_cast<ssize_t>(size)));
+    if (!d) {
+        throw error_already_set();
+    }
+    return d;
+#else
+    (void) size;
+    return dict();
+#endif
+}
+
 template <typename Type, typename Key, typename Value>
 struct map_caster {
     using key_conv = make_caster<Key>;
@@ -269,7 +290,7 @@ public:
 
     template <typename T>
     static handle cast(T &&src, return_value_policy policy, handle parent) {
-        dict d;
+        dict d = new_presized_dict(src.size());
         return_value_policy policy_key = policy;
         return_value_policy policy_value = policy;
         if (!std::is_lvalue_reference<T>::value) {
@@ -281,10 +302,9 @@ public:
                 key_conv::cast(detail::forward_like<T>(kv.first), policy_key, parent));
             auto value = reinterpret_steal<object>(
                 value_conv::cast(detail::forward_like<T>(kv.second), policy_value, parent));
-            if (!key || !value) {
+            if (!key || !value || PyDict_SetItem(d.ptr(), key.ptr(), value.ptr()) != 0) {
                 return handle();
             }
-            d[std::move(key)] = std::move(value);
         }
         return d.release();
     }
@@ -295,6 +315,185 @@ public:
                              + const_name("]"));
 };
 
+// Kind of the items of a buffer with a single-item format in native byte order: 'i' (signed
+// integer), 'u' (unsigned integer), 'f' (floating point), or 0 (anything else).
+inline char buffer_item_kind(const std::string &format) {
+    size_t pos = 0;
+    if (!format.empty()
+        && (format[0] == '@' || format[0] == '='
+#if PY_LITTLE_ENDIAN
+            || format[0] == '<'
+#else
+            || format[0] == '>' || format[0] == '!'
+#endif
+            )) {
+        pos = 1;
+    }
+    if (format.size() != pos + 1) {
+        return 0;
+    }
+    switch (format[pos]) {
+        case 'b':
+        case 'h':
+        case 'i':
+        case 'l':
+        case 'q':
+        case 'n':
+            return 'i';
+        case 'B':
+        case 'H':
+        case 'I':
+        case 'L':
+        case 'Q':
+        case 'N':
+            return 'u';
+        case 'f':
+        case 'd':
+        case 'g':
+            return 'f';
+        default:
+            return 0;
+    }
+}
+
+template <typename T>
+constexpr char buffer_item_kind_of() {
+    return std::is_floating_point<T>::value ? 'f' : std::is_signed<T>::value ? 'i' : 'u';
+}
+
+template <typename T, enable_if_t<std::is_signed<T>::value, int> = 0>
+bool is_negative(T v) {
+    return v < 0;
+}
+template <typename T, enable_if_t<!std::is_signed<T>::value, int> = 0>
+constexpr bool is_negative(T) {
+    return false;
+}
+
+// Integer to integer: the value must be representable (like the scalar integer caster).
+template <typename Dst,
+          typename Src,
+          enable_if_t<std::is_integral<Dst>::value && std::is_integral<Src>::value, int> = 0>
+bool convert_buffer_item(Src src, Dst &dst) {
+    dst = static_cast<Dst>(src);
+    return static_cast<Src>(dst) == src && is_negative(dst) == is_negative(src);
+}
+// Integer or floating point to floating point (like the scalar float caster).
+template <typename Dst, typename Src, enable_if_t<std::is_floating_point<Dst>::value, int> = 0>
+bool convert_buffer_item(Src src, Dst &dst) {
+    dst = static_cast<Dst>(src);
+    return true;
+}
+
+template <typename Src, typename Dst>
+bool copy_buffer_items(const buffer_info &info, Dst *out) {
+    const auto *ptr = static_cast<const char *>(info.ptr);
+    for (ssize_t i = 0; i < info.shape[0]; ++i, ptr += info.strides[0]) {
+        Src item;
+        std::memcpy(&item, ptr, sizeof(Src)); // The buffer may be unaligned.
+        if (!convert_buffer_item(item, out[i])) {
+            return false;
+        }
+    }
+    return true;
+}
+
+template <typename Dst>
+bool copy_floating_point_buffer_items(const buffer_info &info, Dst *out, std::true_type) {
+    if (info.itemsize == sizeof(float)) {
+        return copy_buffer_items<float>(info, out);
+    }
+    if (info.itemsize == sizeof(double)) {
+        return copy_buffer_items<double>(info, out);
+    }
+    if (info.itemsize == sizeof(long double)) {
+        return copy_buffer_items<long double>(info, out);
+    }
+    return false;
+}
+// Floating point items are never converted to integers (like the scalar integer caster).
+template <typename Dst>
+bool copy_floating_point_buffer_items(const buffer_info &, Dst *, std::false_type) {
+    return false;
+}
+
+template <typename Dst>
+bool copy_converted_buffer_items(const buffer_info &info, char kind, Dst *out) {
+    switch (kind) {
+        case 'i':
+            switch (info.itemsize) {
+                case 1:
+                    return copy_buffer_items<std::int8_t>(info, out);
+                case 2:
+                    return copy_buffer_items<std::int16_t>(info, out);
+                case 4:
+                    return copy_buffer_items<std::int32_t>(info, out);
+                case 8:
+                    return copy_buffer_items<std::int64_t>(info, out);
+                default:
+                    return false;
+            }
+        case 'u':
+            switch (info.itemsize) {
+                case 1:
+                    return copy_buffer_items<std::uint8_t>(info, out);
+                case 2:
+                    return copy_buffer_items<std::uint16_t>(info, out);
+                case 4:
+                    return copy_buffer_items<std::uint32_t>(info, out);
+                case 8:
+                    return copy_buffer_items<std::uint64_t>(info, out);
+                default:
+                    return false;
+            }
+        default:
+            return copy_floating_point_buffer_items(info, out, std::is_floating_point<Dst>{});
+    }
+}
+
+template <typename Type>
+struct is_std_vector : std::false_type {};
+template <typename Value, typename Alloc>
+struct is_std_vector<std::vector<Value, Alloc>> : std::true_type {};
+
+// Arithmetic types handled by the scalar integer and floating point casters.
+template <typename T>
+using is_numeric_value = bool_constant<std::is_arithmetic<T>::value && !std::is_same<T, bool>::value
+                                       && !is_std_char_type<T>::value>;
+
+// Unboxes an exact Python `float` or `int` without going through the scalar caster. Returns
+// false for any other object, or if the value is not representable: the item then needs to be
+// loaded with the scalar caster.
+template <typename T, enable_if_t<std::is_floating_point<T>::value, int> = 0>
+bool unbox_exact_numeric(PyObject *src, T &dst) {
+    if (!PyFloat_CheckExact(src)) {
+        return false;
+    }
+    dst = static_cast<T>(PyFloat_AS_DOUBLE(src));
+    return true;
+}
+template <typename T, enable_if_t<std::is_integral<T>::value, int> = 0>
+bool unbox_exact_numeric(PyObject *src, T &dst) {
+    if (!PyLong_CheckExact(src)) {
+        return false;
+    }
+#if PY_VERSION_HEX >= 0x030C0000 && !defined(PYPY_VERSION) && !defined(GRAALVM_PYTHON)
+    const auto *src_long = reinterpret_cast<PyLongObject *>(src);
+    if (PyUnstable_Long_IsCompact(src_long)) {
+        return convert_buffer_item(PyUnstable_Long_CompactValue(src_long), dst);
+    }
+    return false;
+#else
+    int overflow = 0;
+    long long src_value = PyLong_AsLongLongAndOverflow(src, &overflow);
+    if (overflow != 0 || (src_value == -1 && PyErr_Occurred())) {
+        PyErr_Clear();
+        return false;
+    }
+    return convert_buffer_item(src_value, dst);
+#endif
+}
+
 template <typename Type, typename Value>
 struct list_caster {
     using value_conv = make_caster<Value>;
@@ -303,6 +502,9 @@ struct list_caster {
         if (!object_is_convertible_to_std_vector(src)) {
             return false;
         }
+        if (load_buffer(src, convert, &value)) {
+            return true;
+        }
         if (isinstance<sequence>(src)) {
             return convert_elements(src, convert);
         }
@@ -318,6 +520,49 @@ struct list_caster {
     }
 
 private:
+    // Bulk path for std::vector of arithmetic types (not bool or characters), from any
+    // one-dimensional buffer (e.g. NumPy arrays, array.array, memoryview). Items with the same
+    // kind and size are copied as is, also with `convert == false`; other integer and floating
+    // point items are converted only with `convert == true`, following the rules of the scalar
+    // casters. Returns false if the generic sequence path needs to be taken.
+    template <typename T = Type,
+              enable_if_t<is_std_vector<T>::value && is_numeric_value<Value>::value, int> = 0>
+    bool load_buffer(handle src, bool convert, Type *) {
+        if (PyObject_CheckBuffer(src.ptr()) == 0) {
+            return false;
+        }
+        auto *view = new Py_buffer();
+        if (PyObject_GetBuffer(src.ptr(), view, PyBUF_STRIDES | PyBUF_FORMAT) != 0) {
+            delete view;
+            PyErr_Clear();
+            return false;
+        }
+        buffer_info info(view);
+        char kind = buffer_item_kind(info.format);
+        if (info.ndim != 1 || kind == 0) {
+            return false;
+        }
+        bool exact = kind == buffer_item_kind_of<Value>()
+                     && info.itemsize == static_cast<ssize_t>(sizeof(Value));
+        if (!exact && !convert) {
+            return false;
+        }
+        value.resize(static_cast<size_t>(info.shape[0]));
+        if (exact && info.strides[0] == info.itemsize) {
+            if (!value.empty()) {
+                std::memcpy(value.data(), info.ptr, value.size() * sizeof(Value));
+            }
+            return true;
+        }
+        if (exact ? copy_buffer_items<Value>(info, value.data())
+                  : copy_converted_buffer_items(info, kind, value.data())) {
+            return true;
+        }
+        value.clear();
+        return false;
+    }
+    bool load_buffer(handle, bool, void *) { return false; }
+
     template <typename T = Type, enable_if_t<has_reserve_method<T>::value, int> = 0>
     void reserve_maybe(const sequence &s, Type *) {
         value.reserve(s.size());
@@ -325,6 +570,36 @@ private:
     void reserve_maybe(const sequence &, void *) {}
 
     bool convert_elements(handle seq, bool convert) {
+        return convert_elements(seq, convert, is_numeric_value<Value>{});
+    }
+
+    // Fast path for `list` and `tuple` of numbers: exact `float`/`int` items are unboxed
+    // directly, all other items are loaded with the scalar caster.
+    bool convert_elements(handle seq, bool convert, std::true_type) {
+        if (!PyList_CheckExact(seq.ptr()) && !PyTuple_CheckExact(seq.ptr())) {
+            return convert_elements(seq, convert, std::false_type{});
+        }
+        value.clear();
+        reserve_maybe(reinterpret_borrow<sequence>(seq), &value);
+        scoped_critical_section guard(seq);
+        // The size is checked in every iteration: loading an item with the scalar caster may
+        // call back into Python, which may modify the list.
+        for (ssize_t i = 0; i < PySequence_Fast_GET_SIZE(seq.ptr()); ++i) {
+            Value item_value{};
+            if (!unbox_exact_numeric(PySequence_Fast_GET_ITEM(seq.ptr(), i), item_value)) {
+                auto item = reinterpret_borrow<object>(PySequence_Fast_GET_ITEM(seq.ptr(), i));
+                value_conv conv;
+                if (!conv.load(item, convert)) {
+                    return false;
+                }
+                item_value = cast_op<Value &&>(std::move(conv));
+            }
+            value.push_back(item_value);
+        }
+        return true;
+    }
+
+    bool convert_elements(handle seq, bool convert, std::false_type) {
         auto s = reinterpret_borrow<sequence>(seq);
         value.clear();
         reserve_maybe(s, &value);
@@ -347,12 +622,11 @@ public:
         list l(src.size());
         ssize_t index = 0;
         for (auto &&value : src) {
-            auto value_ = reinterpret_steal<object>(
-                value_conv::cast(detail::forward_like<T>(value), policy, parent));
-            if (!value_) {
+            PyObject *item = value_conv::cast(detail::forward_like<T>(value), policy, parent).ptr();
+            if (!item) {
                 return handle();
             }
-            PyList_SET_ITEM(l.ptr(), index++, value_.release().ptr()); // steals a reference
+            PyList_SET_ITEM(l.ptr(), index++, item); // steals a reference
         }
         return l.release();
     }
@@ -457,12 +731,11 @@ public:
         list l(src.size());
         ssize_t index = 0;
         for (auto &&value : src) {
-            auto value_ = reinterpret_steal<object>(
-                value_conv::cast(detail::forward_like<T>(value), policy, parent));
-            if (!value_) {
+            PyObject *item = value_conv::cast(detail::forward_like<T>(value), policy, parent).ptr();
+            if (!item) {
                 return handle();
             }
-            PyList_SET_ITEM(l.ptr(), index++, value_.release().ptr()); // steals a reference
+            PyList_SET_ITEM(l.ptr(), index++, item); // steals a reference
         }
         return l.release();
     }
@@ -508,6 +781,79 @@ struct type_caster<std::array<Type, Size>>
 template <typename Type>
 struct type_caster<std::valarray<Type>> : array_caster<std::valarray<Type>, Type, true> {};
 
+#if defined(PYBIND11_HAS_SPAN)
+// Views the memory of a one-dimensional, C-contiguous and aligned buffer with a matching item
+// type, without copying. The buffer is held by the caster, so the span is valid for the duration
+// of the call. Spans of non-const items require a writable buffer.
+template <typename Type, size_t Extent>
+struct type_caster<std::span<Type, Extent>,
+                   enable_if_t<is_numeric_value<remove_cv_t<Type>>::value>> {
+    using value_type = remove_cv_t<Type>;
+    using value_conv = make_caster<value_type>;
+
+    bool load(handle src, bool) {
+        if (!src || !PyObject_CheckBuffer(src.ptr())) {
+            return false;
+        }
+        auto view = reinterpret_steal<object>(PyMemoryView_FromObject(src.ptr()));
+        if (!view) {
+            PyErr_Clear();
+            return false;
+        }
+        const Py_buffer *buf = PyMemoryView_GET_BUFFER(view.ptr());
+        if (buf->ndim != 1 || !PyBuffer_IsContiguous(buf, 'C')
+            || buf->itemsize != static_cast<ssize_t>(sizeof(value_type))
+            || buffer_item_kind(buf->format ? buf->format : "B")
+                   != buffer_item_kind_of<value_type>()) {
+            return false;
+        }
+        if (!std::is_const<Type>::value && buf->readonly) {
+            return false;
+        }
+        auto size = static_cast<size_t>(buf->shape ? buf->shape[0] : buf->len / buf->itemsize);
+        if (Extent != std::dynamic_extent && size != Extent) {
+            return false;
+        }
+        // Unlike a copy, a view cannot be made of items that are not suitably aligned (the
+        // pointer of an empty buffer is never dereferenced).
+        if (size != 0 && reinterpret_cast<std::uintptr_t>(buf->buf) % alignof(value_type) != 0) {
+            return false;
+        }
+        data = static_cast<Type *>(buf->buf);
+        count = size;
+        buffer = std::move(view);
+        return true;
+    }
+
+    template <typename T>
+    static handle cast(T &&src, return_value_policy policy, handle parent) {
+        list l(src.size());
+        ssize_t index = 0;
+        for (auto &&value : src) {
+            auto value_ = reinterpret_steal<object>(value_conv::cast(value, policy, parent));
+            if (!value_) {
+                return handle();
+            }
+            PyList_SET_ITEM(l.ptr(), index++, value_.release().ptr());
+        }
+        return l.release();
+    }
+
+    // `io_name` cannot nest the (input/output dependent) item name, so the output is a bare list.
+    static constexpr auto name = io_name("collections.abc.Buffer", "list");
+
+    template <typename T>
+    using cast_op_type = std::span<Type, Extent>;
+
+    explicit operator std::span<Type, Extent>() { return std::span<Type, Extent>(data, count); }
+
+private:
+    object buffer;
+    Type *data = nullptr;
+    size_t count = 0;
+};
+#endif
+
 template <typename Key, typename Compare, typename Alloc>
 struct type_caster<std::set<Key, Compare, Alloc>>
     : set_caster<std::set<Key, Compare, Alloc>, Key> {};
@@ -578,6 +924,97 @@ struct type_caster<std::experimental::nullopt_t>
     : public void_caster<std::experimental::nullopt_t> {};
 #endif
 
+// Filters for the alternatives of a variant: `rejects(caster, type, convert)` returns true only
+// if `caster.load(src, convert)` is certain to fail for *every* object `src` of type `type`, so
+// that trying the caster can be skipped. This depends on the Python type alone, not on values
+// (e.g. an `int` may or may not fit into an `int32_t`), so skipping never changes which
+// alternative is selected. The default is to not know anything and to always try the caster.
+template <typename Caster, typename SFINAE = void>
+struct variant_alternative_filter {
+    static bool rejects(const Caster &, PyTypeObject *, bool) { return false; }
+};
+
+// Mirrors `PyNumber_Check()`, for a type instead of an object.
+inline bool variant_type_is_number(PyTypeObject *type) {
+    const PyNumberMethods *nb = type->tp_as_number;
+    return (nb != nullptr && (nb->nb_index != nullptr || nb->nb_int != nullptr
+                              || nb->nb_float != nullptr))
+           || PyType_IsSubtype(type, &PyComplex_Type) != 0;
+}
+
+// Integer and floating point casters: mirrors the checks in their `load()`.
+template <typename T>
+struct variant_alternative_filter<type_caster<T>,
+                                  enable_if_t<std::is_arithmetic<T>::value
+                                              && !std::is_same<T, bool>::value
+                                              && !is_std_char_type<T>::value>> {
+    static bool rejects(const type_caster<T> &, PyTypeObject *type, bool convert) {
+        bool is_float = PyType_IsSubtype(type, &PyFloat_Type) != 0;
+        if (std::is_floating_point<T>::value) {
+            return !is_float && (!convert || !variant_type_is_number(type));
+        }
+        if (is_float) {
+            return true;
+        }
+        bool has_index = type->tp_as_number != nullptr && type->tp_as_number->nb_index != nullptr;
+        return !PyType_IsSubtype(type, &PyLong_Type) && !has_index
+               && (!convert || !variant_type_is_number(type));
+    }
+};
+
+template <typename StringType, bool IsView>
+std::true_type is_string_caster_impl(const string_caster<StringType, IsView> *);
+std::false_type is_string_caster_impl(...);
+
+// String casters only accept `str`, `bytes` and `bytearray` objects.
+template <typename Caster>
+struct variant_alternative_filter<
+    Caster,
+    enable_if_t<decltype(is_string_caster_impl(std::declval<Caster *>()))::value>> {
+    static bool rejects(const Caster &, PyTypeObject *type, bool) {
+        return PyType_IsSubtype(type, &PyUnicode_Type) == 0
+               && PyType_IsSubtype(type, &PyBytes_Type) == 0
+               && PyType_IsSubtype(type, &PyByteArray_Type) == 0;
+    }
+};
+
+// `None`-only casters, e.g. for `std::monostate`.
+template <typename T>
+struct variant_alternative_filter<
+    type_caster<T>,
+    enable_if_t<std::is_base_of<void_caster<T>, type_caster<T>>::value>> {
+    static bool rejects(const type_caster<T> &, PyTypeObject *type, bool) {
+        return type != Py_TYPE(Py_None);
+    }
+};
+
+// Exact instances of these builtin types are never instances of a bound class and have no
+// attributes that the class casters look for (`_pybind11_conduit_v1_` etc.).
+inline bool variant_type_is_plain_builtin(PyTypeObject *type) {
+    return type == &PyLong_Type || type == &PyFloat_Type || type == &PyBool_Type
+           || type == &PyComplex_Type || type == &PyUnicode_Type || type == &PyBytes_Type
+           || type == &PyByteArray_Type || type == &PyList_Type || type == &PyTuple_Type
+           || type == &PyDict_Type || type == &PySet_Type || type == &PyFrozenSet_Type;
+}
+
+// Casters for bound classes (unless they replace the generic `load()`): they can only accept
+// a plain builtin object through an implicit conversion.
+template <typename Caster>
+struct variant_alternative_filter<
+    Caster,
+    enable_if_t<std::is_base_of<type_caster_generic, Caster>::value
+                && std::is_same<decltype(&Caster::load),
+                                bool (type_caster_generic::*)(handle, bool)>::value>> {
+    static bool rejects(const Caster &caster, PyTypeObject *type, bool convert) {
+        if (!variant_type_is_plain_builtin(type)) {
+            return false;
+        }
+        const type_info *tinfo = caster.typeinfo;
+        return !convert || tinfo == nullptr
+               || (tinfo->implicit_conversions.empty() && tinfo->direct_conversions->empty());
+    }
+};
+
 /// Visit a variant and cast any found type to Python
 struct variant_caster_visitor {
     return_value_policy policy;
@@ -614,7 +1051,7 @@ struct variant_caster<V<Ts...>> {
     template <typename U, typename... Us>
     bool load_alternative(handle src, bool convert, type_list<U, Us...>) {
         auto caster = make_caster<U>();
-        if (caster.load(src, convert)) {
+        if (!rejects_type(caster, Py_TYPE(src.ptr()), convert) && caster.load(src, convert)) {
             value = cast_op<U>(std::move(caster));
             return true;
         }
@@ -623,7 +1060,22 @@ struct variant_caster<V<Ts...>> {
 
     bool load_alternative(handle, bool, type_list<>) { return false; }
 
+    template <typename Caster>
+    static bool rejects_type(const Caster &caster, PyTypeObject *type, bool convert) {
+#if defined(PYPY_VERSION) || defined(GRAALVM_PYTHON)
+        (void) caster;
+        (void) type;
+        (void) convert;
+        return false;
+#else
+        return variant_alternative_filter<Caster>::rejects(caster, type, convert);
+#endif
+    }
+
     bool load(handle src, bool convert) {
+        if (!src) {
+            return false;
+        }
         // Do a first pass without conversions to improve constructor resolution.
         // E.g. `py::int_(1).cast<variant<double, int>>()` needs to fill the `int`
         // slot of the variant. Without two-pass loading `double` would be filled
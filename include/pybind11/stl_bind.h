@@ -15,6 +15,7 @@
 #include "operators.h"
 
 #include <algorithm>
+#include <iterator>
 #include <sstream>
 #include <type_traits>
 
@@ -855,4 +856,217 @@ class_<Map, holder_type> bind_map(handle scope, const std::string &name, Args &&
     return cl;
 }
 
+PYBIND11_NAMESPACE_BEGIN(detail)
+
+template <typename Container>
+struct readonly_sequence_view {
+    const Container *container;
+    object owner; // Keeps `container` alive.
+};
+
+template <typename Container>
+struct readonly_mapping_view {
+    const Container *container;
+    object owner; // Keeps `container` alive.
+};
+
+template <typename T, typename SFINAE = void>
+struct is_mapping_container : std::false_type {};
+
+template <typename T>
+struct is_mapping_container<T, void_t<typename T::key_type, typename T::mapped_type>>
+    : std::true_type {};
+
+inline void register_readonly_view_abc(handle cls, const char *abc_name) {
+    module_::import("collections.abc").attr(abc_name).attr("register")(cls);
+}
+
+template <typename Container>
+object
+make_readonly_view(const Container &container, handle owner, std::false_type /*is_mapping*/) {
+    using View = readonly_sequence_view<Container>;
+    using SizeType = typename Container::size_type;
+    using DiffType = typename Container::difference_type;
+    using ConstReference = typename Container::const_reference;
+    static_assert(
+        std::is_base_of<std::random_access_iterator_tag,
+                        typename std::iterator_traits<
+                            typename Container::const_iterator>::iterator_category>::value,
+        "py::readonly_view() requires a map or a container with random access iterators");
+
+    if (!get_type_info(typeid(View), false)) {
+        class_<View> cl(handle(), "ReadonlySequenceView", pybind11::module_local());
+
+        cl.def("__len__", [](const View &v) { return v.container->size(); });
+
+        cl.def(
+            "__getitem__",
+            [](const View &v, DiffType i) -> ConstReference {
+                auto n = static_cast<DiffType>(v.container->size());
+                if (i < 0) {
+                    i += n;
+                }
+                if (i < 0 || i >= n) {
+                    throw index_error();
+                }
+                return (*v.container)[static_cast<SizeType>(i)];
+            },
+            return_value_policy::reference_internal);
+
+        cl.def("__getitem__", [](handle self, const slice &slice) {
+            const Container &c = *self.cast<const View &>().container;
+            size_t start = 0, stop = 0, step = 0, slicelength = 0;
+            if (!slice.compute(c.size(), &start, &stop, &step, &slicelength)) {
+                throw error_already_set();
+            }
+            list result;
+            for (size_t i = 0; i < slicelength; ++i) {
+                ConstReference item = c[static_cast<SizeType>(start)];
+                result.append(
+                    pybind11::cast(item, return_value_policy::reference_internal, self));
+                start += step;
+            }
+            return result;
+        });
+
+        cl.def(
+            "__iter__",
+            [](const View &v) { return make_iterator(v.container->begin(), v.container->end()); },
+            keep_alive<0, 1>() /* Essential: keep view alive while iterator exists */
+        );
+
+        // Items are compared as Python objects, there is no requirement on `operator==`.
+        cl.def(
+            "count",
+            [](const View &v, const object &x) {
+                size_t n = 0;
+                for (ConstReference item : *v.container) {
+                    if (pybind11::cast(item, return_value_policy::reference).equal(x)) {
+                        ++n;
+                    }
+                }
+                return n;
+            },
+            arg("x"),
+            "Return the number of times ``x`` appears in the sequence");
+
+        cl.def(
+            "index",
+            [](const View &v, const object &x) {
+                size_t i = 0;
+                for (ConstReference item : *v.container) {
+                    if (pybind11::cast(item, return_value_policy::reference).equal(x)) {
+                        return i;
+                    }
+                    ++i;
+                }
+                throw value_error();
+            },
+            arg("x"),
+            "Return the index of the first occurrence of ``x`` in the sequence");
+
+        cl.def("__contains__", [](const View &v, const object &x) {
+            for (ConstReference item : *v.container) {
+                if (pybind11::cast(item, return_value_policy::reference).equal(x)) {
+                    return true;
+                }
+            }
+            return false;
+        });
+
+        register_readonly_view_abc(cl, "Sequence");
+    }
+
+    return cast(View{&container, reinterpret_borrow<object>(owner)});
+}
+
+template <typename Container>
+typename Container::const_iterator readonly_mapping_view_find(const Container &container,
+                                                              handle key) {
+    try {
+        return container.find(key.cast<typename Container::key_type>());
+    } catch (const cast_error &) {
+        return container.end();
+    }
+}
+
+template <typename Container>
+object
+make_readonly_view(const Container &container, handle owner, std::true_type /*is_mapping*/) {
+    using View = readonly_mapping_view<Container>;
+
+    if (!get_type_info(typeid(View), false)) {
+        class_<View> cl(handle(), "ReadonlyMappingView", pybind11::module_local());
+
+        cl.def("__len__", [](const View &v) { return v.container->size(); });
+
+        // Keys that cannot be converted to the C++ key type are not in the map, as with `dict`.
+        cl.def("__getitem__", [](handle self, const object &key) {
+            const Container &c = *self.cast<const View &>().container;
+            auto it = readonly_mapping_view_find(c, key);
+            if (it == c.end()) {
+                set_error(PyExc_KeyError, format_message_key_error_key_object(key));
+                throw error_already_set();
+            }
+            return pybind11::cast(it->second, return_value_policy::reference_internal, self);
+        });
+
+        cl.def(
+            "get",
+            [](handle self, const object &key, const object &default_) {
+                const Container &c = *self.cast<const View &>().container;
+                auto it = readonly_mapping_view_find(c, key);
+                if (it == c.end()) {
+                    return default_;
+                }
+                return pybind11::cast(it->second, return_value_policy::reference_internal, self);
+            },
+            arg("key"),
+            arg("default") = none());
+
+        cl.def("__contains__", [](const View &v, const object &key) {
+            return readonly_mapping_view_find(*v.container, key) != v.container->end();
+        });
+
+        cl.def(
+            "__iter__",
+            [](const View &v) {
+                return make_key_iterator(v.container->begin(), v.container->end());
+            },
+            keep_alive<0, 1>() /* Essential: keep view alive while iterator exists */
+        );
+
+        // The `collections.abc` views are lazy, they go through the methods above.
+        cl.def("keys", [](handle self) {
+            return module_::import("collections.abc").attr("KeysView")(self);
+        });
+        cl.def("values", [](handle self) {
+            return module_::import("collections.abc").attr("ValuesView")(self);
+        });
+        cl.def("items", [](handle self) {
+            return module_::import("collections.abc").attr("ItemsView")(self);
+        });
+
+        register_readonly_view_abc(cl, "Mapping");
+    }
+
+    return cast(View{&container, reinterpret_borrow<object>(owner)});
+}
+
+PYBIND11_NAMESPACE_END(detail)
+
+/// Returns a read-only `collections.abc.Sequence` (for containers with random access iterators)
+/// or `collections.abc.Mapping` (for maps) that refers to `container` in place, instead of
+/// copying it into a new `list` or `dict`. Items are converted to Python objects only when they
+/// are accessed. The view keeps `owner`, the Python object owning `container`, alive (`owner`
+/// can be None for a container with static storage duration).
+template <typename Container>
+object readonly_view(const Container &container, handle owner) {
+    return detail::make_readonly_view(
+        container, owner, detail::is_mapping_container<Container>{});
+}
+
+template <typename Container>
+object readonly_view(const Container &&, handle) = delete;
+
 PYBIND11_NAMESPACE_END(PYBIND11_NAMESPACE)
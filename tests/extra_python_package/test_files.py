@@ -38,6 +38,7 @@ Cflags: -I${{includedir}}
 
 
 main_headers = {
+    "include/pybind11/arrow.h",
     "include/pybind11/attr.h",
     "include/pybind11/buffer_info.h",
     "include/pybind11/cast.h",
@@ -45,6 +46,7 @@ main_headers = {
     "include/pybind11/common.h",
     "include/pybind11/complex.h",
     "include/pybind11/critical_section.h",
+    "include/pybind11/dlpack.h",
     "include/pybind11/eigen.h",
     "include/pybind11/embed.h",
     "include/pybind11/eval.h",
@@ -80,6 +82,7 @@ detail_headers = {
     "include/pybind11/detail/class.h",
     "include/pybind11/detail/common.h",
     "include/pybind11/detail/cpp_conduit.h",
+    "include/pybind11/detail/deferred_cpp_dtor_queue.h",
     "include/pybind11/detail/descr.h",
     "include/pybind11/detail/dynamic_raw_ptr_cast_if_possible.h",
     "include/pybind11/detail/function_record_pyobject.h",
@@ -0,0 +1,287 @@
+/*
+    tests/test_arrow.cpp -- zero-copy column exchange through the Arrow C Data Interface
+
+    Copyright (c) 2025 The Pybind Development Team.
+
+    All rights reserved. Use of this source code is governed by a
+    BSD-style license that can be found in the LICENSE file.
+*/
+
+#include <pybind11/arrow.h>
+#include <pybind11/stl.h>
+
+#include "pybind11_tests.h"
+
+#include <cerrno>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace {
+
+int freed_count = 0;
+
+// std::vector<std::string> is opaque in other test modules: convert explicitly.
+std::vector<std::string> to_strings(const py::list &values) {
+    std::vector<std::string> result;
+    for (auto value : values) {
+        result.push_back(value.cast<std::string>());
+    }
+    return result;
+}
+
+// The elements of an array, with None for the null ones.
+template <typename Array>
+py::list to_list(const Array &array) {
+    py::list result;
+    for (py::ssize_t i = 0; i < array.size(); ++i) {
+        if (array.is_valid(i)) {
+            result.append(py::cast(array[i]));
+        } else {
+            result.append(py::none());
+        }
+    }
+    return result;
+}
+
+// A producer that does not use pybind11's exporter, standing in for another Arrow library: it
+// exports sliced ``large_string`` arrays (format "U") without computing their null count.
+using py::detail::arrow_c_array;
+using py::detail::arrow_c_schema;
+using py::detail::arrow_c_stream;
+
+struct foreign_counts {
+    int live_storages = 0;
+    int exported_arrays = 0;
+    int released_arrays = 0;
+    int exported_streams = 0;
+    int released_streams = 0;
+} foreign;
+
+struct ForeignStorage {
+    std::vector<std::uint8_t> validity;
+    std::vector<std::int64_t> offsets{0};
+    std::string chars;
+
+    ForeignStorage() { ++foreign.live_storages; }
+    ForeignStorage(const ForeignStorage &) = delete;
+    ~ForeignStorage() { --foreign.live_storages; }
+};
+
+// The elements [offset, offset + length) of `values`, None being null. A negative length
+// selects all the elements from `offset`.
+struct ForeignStrings {
+    std::shared_ptr<ForeignStorage> storage;
+    std::int64_t offset;
+    std::int64_t length;
+};
+
+ForeignStrings
+make_foreign_strings(const py::list &values, std::int64_t offset, std::int64_t length) {
+    ForeignStrings result{std::make_shared<ForeignStorage>(), offset, length};
+    auto &storage = *result.storage;
+    storage.validity.resize((values.size() + 7) / 8);
+    size_t i = 0;
+    for (auto value : values) {
+        if (!value.is_none()) {
+            storage.validity[i / 8] |= static_cast<std::uint8_t>(1 << (i % 8));
+            storage.chars += value.cast<std::string>();
+        }
+        storage.offsets.push_back(static_cast<std::int64_t>(storage.chars.size()));
+        ++i;
+    }
+    if (length < 0) {
+        result.length = static_cast<std::int64_t>(values.size()) - offset;
+    }
+    return result;
+}
+
+void foreign_export_schema(arrow_c_schema *out) {
+    *out = arrow_c_schema{};
+    out->format = "U";
+    out->flags = py::detail::arrow_flag_nullable;
+    out->release = [](arrow_c_schema *self) { self->release = nullptr; };
+}
+
+void foreign_export_array(const ForeignStrings &strings, arrow_c_array *out) {
+    struct context {
+        std::shared_ptr<ForeignStorage> storage;
+        const void *buffers[3];
+    };
+    const auto &storage = *strings.storage;
+    auto *ctx = new context{
+        strings.storage,
+        {storage.validity.data(), storage.offsets.data(), storage.chars.data()}};
+    *out = arrow_c_array{};
+    out->length = strings.length;
+    out->null_count = -1; // Unknown: left to the consumer to count.
+    out->offset = strings.offset;
+    out->n_buffers = 3;
+    out->buffers = ctx->buffers;
+    out->private_data = ctx;
+    out->release = [](arrow_c_array *self) {
+        delete static_cast<context *>(self->private_data);
+        self->release = nullptr;
+        ++foreign.released_arrays;
+    };
+    ++foreign.exported_arrays;
+}
+
+// The chunks of a stream, failing to produce the chunk `fail_at` if it is not -1.
+struct ForeignStream {
+    std::vector<ForeignStrings> chunks;
+    int fail_at;
+};
+
+void foreign_export_stream(const ForeignStream &stream, arrow_c_stream *out) {
+    struct context {
+        ForeignStream stream;
+        size_t next;
+    };
+    *out = arrow_c_stream{};
+    out->private_data = new context{stream, 0};
+    out->get_schema = [](arrow_c_stream *, arrow_c_schema *schema) {
+        foreign_export_schema(schema);
+        return 0;
+    };
+    out->get_next = [](arrow_c_stream *self, arrow_c_array *array) {
+        auto *ctx = static_cast<context *>(self->private_data);
+        if (static_cast<int>(ctx->next) == ctx->stream.fail_at) {
+            return EIO;
+        }
+        if (ctx->next == ctx->stream.chunks.size()) {
+            array->release = nullptr; // End of the stream.
+            return 0;
+        }
+        foreign_export_array(ctx->stream.chunks[ctx->next++], array);
+        return 0;
+    };
+    out->get_last_error = [](arrow_c_stream *self) -> const char * {
+        auto *ctx = static_cast<context *>(self->private_data);
+        return static_cast<int>(ctx->next) == ctx->stream.fail_at ? "injected failure" : nullptr;
+    };
+    out->release = [](arrow_c_stream *self) {
+        delete static_cast<context *>(self->private_data);
+        self->release = nullptr;
+        ++foreign.released_streams;
+    };
+    ++foreign.exported_streams;
+}
+
+} // namespace
+
+TEST_SUBMODULE(arrow, m) {
+    m.def("to_list", &to_list<py::arrow_array<std::int32_t>>);
+    m.def("to_list", &to_list<py::arrow_array<double>>);
+    m.def("to_list", &to_list<py::arrow_string_array>);
+    m.def("info", [](const py::arrow_array<std::int32_t> &a) {
+        return py::make_tuple(
+            reinterpret_cast<std::uintptr_t>(a.data()), a.size(), a.null_count());
+    });
+    m.def("sum", [](const py::arrow_array<double> &a) {
+        double total = 0;
+        for (double value : a) {
+            total += value;
+        }
+        return total;
+    });
+    m.def("chunked_info", [](const py::arrow_chunked_array<py::arrow_array<double>> &c) {
+        py::list chunks;
+        for (const auto &chunk : c.chunks()) {
+            chunks.append(to_list(chunk));
+        }
+        return py::make_tuple(chunks, c.size(), c.null_count());
+    });
+    m.def("join", [](const py::arrow_chunked_array<py::arrow_string_array> &c) {
+        std::string joined;
+        for (const auto &chunk : c.chunks()) {
+            for (py::ssize_t i = 0; i < chunk.size(); ++i) {
+                joined.append(chunk.value_data(i), static_cast<size_t>(chunk.value_size(i)));
+            }
+        }
+        return joined;
+    });
+
+    m.def("arange", [](std::int32_t n) {
+        std::vector<std::int32_t> values(static_cast<size_t>(n));
+        for (std::int32_t i = 0; i < n; ++i) {
+            values[static_cast<size_t>(i)] = i;
+        }
+        return py::arrow_array<std::int32_t>(std::move(values));
+    });
+    m.def("with_nulls", []() {
+        static const std::int32_t values[] = {10, 0, 30, 0, 50, 60, 70, 80, 0};
+        // Bits 1, 3 and 8 are 0: the elements 1, 3 and 8 are null.
+        static const std::uint8_t validity[] = {0xF5, 0xFE};
+        return py::arrow_array<std::int32_t>(values, 9, nullptr, validity);
+    });
+    m.def("strings", [](const py::list &values) {
+        return py::arrow_string_array(to_strings(values));
+    });
+    m.def("chunked", [](const std::vector<std::vector<double>> &chunks) {
+        std::vector<py::arrow_array<double>> arrays;
+        for (auto chunk : chunks) {
+            arrays.emplace_back(std::move(chunk));
+        }
+        return py::arrow_chunked_array<py::arrow_array<double>>(std::move(arrays));
+    });
+    m.def("chunked_strings", [](const py::list &chunks) {
+        std::vector<py::arrow_string_array> arrays;
+        for (auto chunk : chunks) {
+            arrays.emplace_back(to_strings(chunk.cast<py::list>()));
+        }
+        return py::arrow_chunked_array<py::arrow_string_array>(std::move(arrays));
+    });
+    m.def("tracked", []() {
+        std::shared_ptr<std::vector<double>> storage(new std::vector<double>(3, 1.5),
+                                                     [](std::vector<double> *v) {
+                                                         ++freed_count;
+                                                         delete v;
+                                                     });
+        return py::arrow_array<double>(storage->data(), 3, storage);
+    });
+    m.def("freed_count", []() { return freed_count; });
+
+    m.def("string_info", [](const py::arrow_chunked_array<py::arrow_string_array> &c) {
+        return py::make_tuple(c.chunks().size(), c.size(), c.null_count());
+    });
+    py::class_<ForeignStrings>(m, "ForeignStrings")
+        .def(py::init(&make_foreign_strings), py::arg("values"), py::arg("offset") = 0,
+             py::arg("length") = -1)
+        .def("__arrow_c_schema__",
+             [](const ForeignStrings &) {
+                 std::unique_ptr<arrow_c_schema> schema(new arrow_c_schema());
+                 foreign_export_schema(schema.get());
+                 return py::detail::arrow_capsule(schema.release(), "arrow_schema");
+             })
+        .def(
+            "__arrow_c_array__",
+            [](const ForeignStrings &self, const py::object &) {
+                std::unique_ptr<arrow_c_schema> schema(new arrow_c_schema());
+                foreign_export_schema(schema.get());
+                std::unique_ptr<arrow_c_array> array(new arrow_c_array());
+                foreign_export_array(self, array.get());
+                return py::make_tuple(py::detail::arrow_capsule(schema.release(), "arrow_schema"),
+                                      py::detail::arrow_capsule(array.release(), "arrow_array"));
+            },
+            py::arg("requested_schema") = py::none());
+    py::class_<ForeignStream>(m, "ForeignStream")
+        .def(py::init<std::vector<ForeignStrings>, int>(),
+             py::arg("chunks"),
+             py::arg("fail_at") = -1)
+        .def(
+            "__arrow_c_stream__",
+            [](const ForeignStream &self, const py::object &) {
+                std::unique_ptr<arrow_c_stream> stream(new arrow_c_stream());
+                foreign_export_stream(self, stream.get());
+                return py::detail::arrow_capsule(stream.release(), "arrow_array_stream");
+            },
+            py::arg("requested_schema") = py::none());
+    m.def("foreign_counts", []() {
+        return py::make_tuple(foreign.live_storages,
+                              foreign.exported_arrays - foreign.released_arrays,
+                              foreign.exported_streams - foreign.released_streams);
+    });
+}
@@ -0,0 +1,139 @@
+from __future__ import annotations
+
+import gc
+
+import pytest
+
+from pybind11_tests import arrow as m
+
+
+def test_primitive_round_trip():
+    a = m.arange(5)
+    assert len(a) == 5
+    assert m.to_list(a) == [0, 1, 2, 3, 4]
+    # Zero-copy: the same buffer is seen by every consumer.
+    assert m.info(a)[0] == m.info(a)[0]
+    assert m.info(a)[1:] == (5, 0)
+
+    b = m.with_nulls()
+    assert m.to_list(b) == [10, None, 30, None, 50, 60, 70, 80, None]
+    assert m.info(b)[1:] == (9, 3)
+
+
+def test_strings():
+    values = ["", "pybind11", "naïve", "\U0001f40d"]
+    s = m.strings(values)
+    assert len(s) == 4
+    assert m.to_list(s) == values
+    assert m.to_list(m.strings([])) == []
+
+
+def test_type_mismatch():
+    with pytest.raises(TypeError):
+        m.sum(m.arange(3))
+    with pytest.raises(TypeError):
+        m.sum([1.0, 2.0])
+    with pytest.raises(TypeError):
+        m.join(m.chunked([[1.0]]))
+
+
+def test_capsules():
+    a = m.arange(2)
+    schema, array = a.__arrow_c_array__()
+    assert '"arrow_schema"' in repr(schema)
+    assert '"arrow_array"' in repr(array)
+    assert '"arrow_schema"' in repr(a.__arrow_c_schema__())
+    assert a.__arrow_c_array__(requested_schema=schema) is not None
+
+    c = m.chunked([[1.0]])
+    assert '"arrow_array_stream"' in repr(c.__arrow_c_stream__())
+    assert not hasattr(a, "__arrow_c_stream__")
+
+
+def test_chunked():
+    c = m.chunked([[1.0, 2.0], [], [3.0]])
+    assert len(c) == 3
+    assert m.chunked_info(c) == ([[1.0, 2.0], [], [3.0]], 3, 0)
+    # A stream can be read several times.
+    assert m.chunked_info(c)[1] == 3
+    assert m.chunked_info(m.chunked([])) == ([], 0, 0)
+    # A single array is a single chunk.
+    assert m.chunked_info(m.tracked()) == ([[1.5, 1.5, 1.5]], 3, 0)
+
+    s = m.chunked_strings([["a", "bc"], ["", "def"]])
+    assert m.join(s) == "abcdef"
+    assert m.join(m.strings(["x", "y"])) == "xy"
+
+
+def test_lifetime():
+    before = m.freed_count()
+    a = m.tracked()
+    unused = [a.__arrow_c_array__(), a.__arrow_c_schema__()]
+    sums = [m.sum(a), m.chunked_info(a)]
+    del a, unused, sums
+    gc.collect()
+    assert m.freed_count() == before + 1
+
+
+def test_pyarrow():
+    pa = pytest.importorskip("pyarrow")
+
+    a = pa.array(m.with_nulls())
+    assert a.type == pa.int32()
+    assert a.to_pylist() == [10, None, 30, None, 50, 60, 70, 80, None]
+    assert m.to_list(a.slice(1, 4)) == [None, 30, None, 50]
+    assert m.info(a.slice(2))[0] == a.buffers()[1].address + 8
+    assert m.sum(pa.array([1.5, 2.5])) == 4
+    assert m.to_list(pa.array(m.strings(["a", "bc"]))) == ["a", "bc"]
+    assert m.to_list(pa.array(["x", None], type=pa.large_string())) == ["x", None]
+    assert m.join(pa.chunked_array([["a"], ["b", "c"]])) == "abc"
+    assert pa.chunked_array(m.chunked([[1.0], [2.0, 3.0]])).num_chunks == 2
+
+
+FOREIGN_VALUES = ["zero", None, "two", "three", None, "five", "", "seven", None, "nine"]
+
+
+def test_foreign_array():
+    # Sliced large_string arrays with an unknown null count (-1), as pyarrow exports them.
+    for offset, length in [(0, -1), (1, 7), (2, 6), (9, 1), (10, 0)]:
+        a = m.ForeignStrings(FOREIGN_VALUES, offset, length)
+        expected = FOREIGN_VALUES[offset:][: len(FOREIGN_VALUES) if length < 0 else length]
+        assert m.to_list(a) == expected
+        assert m.string_info(a) == (1, len(expected), expected.count(None))
+    assert m.join(m.ForeignStrings(FOREIGN_VALUES, 2, 4)) == "twothreefive"
+    with pytest.raises(TypeError):
+        m.sum(m.ForeignStrings(FOREIGN_VALUES))
+
+
+def test_foreign_stream():
+    s = m.ForeignStream(
+        [
+            m.ForeignStrings(FOREIGN_VALUES, 0, 3),
+            m.ForeignStrings(FOREIGN_VALUES, 3, 0),
+            m.ForeignStrings(FOREIGN_VALUES, 5),
+        ]
+    )
+    assert m.join(s) == "zerotwofivesevennine"
+    assert m.string_info(s) == (3, 8, 2)
+    assert m.string_info(m.ForeignStream([])) == (0, 0, 0)
+    with pytest.raises(TypeError):
+        m.chunked_info(s)
+    failing = m.ForeignStream([m.ForeignStrings(FOREIGN_VALUES)] * 3, fail_at=2)
+    with pytest.raises(ValueError, match="could not get the next array: injected failure"):
+        m.join(failing)
+
+
+def test_foreign_lifetime():
+    gc.collect()
+    assert m.foreign_counts() == (0, 0, 0)
+    a = m.ForeignStrings(FOREIGN_VALUES, 1)
+    s = m.ForeignStream([a, m.ForeignStrings(FOREIGN_VALUES)], fail_at=1)
+    views = [m.to_list(a), m.string_info(a)]
+    unused = [a.__arrow_c_array__(), a.__arrow_c_schema__(), s.__arrow_c_stream__()]
+    with pytest.raises(ValueError):
+        m.join(s)
+    assert m.foreign_counts()[0] == 2
+    del a, s, views, unused
+    gc.collect()
+    # Every exported array and stream was released, and the storage freed.
+    assert m.foreign_counts() == (0, 0, 0)
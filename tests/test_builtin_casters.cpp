@@ -226,11 +226,20 @@ TEST_SUBMODULE(builtin_casters, m) {
           []() { return py::str(TypeWithBothOperatorStringAndStringView()); });
 #endif
 
+    // test_interned_str
+    m.def("interned_str", [](const std::string &s) { return py::interned_str(s); });
+    m.def("interned_str_bytes",
+          [](const py::bytes &b) { return py::interned_str(static_cast<std::string>(b)); });
+    m.def("interned_str_roundtrip", [](const py::interned_str &s) { return s.value(); });
+    m.def("clear_interned_str_cache", &py::clear_interned_str_cache);
+
     // test_integer_casting
     m.def("i32_str", [](std::int32_t v) { return std::to_string(v); });
     m.def("u32_str", [](std::uint32_t v) { return std::to_string(v); });
     m.def("i64_str", [](std::int64_t v) { return std::to_string(v); });
     m.def("u64_str", [](std::uint64_t v) { return std::to_string(v); });
+    m.def("i16_str", [](std::int16_t v) { return std::to_string(v); });
+    m.def("u16_str", [](std::uint16_t v) { return std::to_string(v); });
 
     // test_int_convert
     m.def("int_passthrough", [](int arg) { return arg; });
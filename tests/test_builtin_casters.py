@@ -224,6 +224,31 @@ def test_string_view(capture):
     assert m.str_from_type_with_both_operator_string_and_string_view() == "success"
 
 
+def test_interned_str():
+    first = m.interned_str("".join(["B", "U", "Y"]))
+    assert first == "BUY"
+    # Repeated values are returned as the same object.
+    assert m.interned_str("BUY") is first
+    assert m.interned_str("") is m.interned_str("")
+    assert m.interned_str("\u20ac") is m.interned_str("\u20ac")
+    # Long strings are not cached.
+    long = "x" * 100
+    assert m.interned_str(long) == long
+    assert m.interned_str(long) is not m.interned_str(long)
+    with pytest.raises(UnicodeDecodeError):
+        m.interned_str_bytes(b"\xff")
+    assert m.interned_str_roundtrip("abc") == "abc"
+    if hasattr(sys, "_is_interned"):
+        # Not interned where that makes strings immortal, so that clearing the cache frees them.
+        assert sys._is_interned(m.interned_str("SELL")) == (not env.PY_GIL_DISABLED)
+
+    if not env.PYPY and not env.GRAALPY:
+        refcount = sys.getrefcount(first)
+        m.clear_interned_str_cache()
+        assert sys.getrefcount(first) == refcount - 1
+        assert m.interned_str("BUY") == "BUY"
+
+
 def test_integer_casting():
     """Issue #929 - out-of-range integer values shouldn't be accepted"""
     assert m.i32_str(-1) == "-1"
@@ -247,6 +272,39 @@ def test_integer_casting():
     assert "incompatible function arguments" in str(excinfo.value)
 
 
+def test_small_integer_casting():
+    # Values around the limits of the narrow C++ types, and around the largest
+    # CPython "compact" int values (read without calling PyLong_AsLong).
+    for v in (0, 1, -1, 2**15 - 1, -(2**15)):
+        assert m.i16_str(v) == str(v)
+    for v in (0, 2**16 - 1):
+        assert m.u16_str(v) == str(v)
+    for v in (2**15, -(2**15) - 1, 2**30 - 1, -(2**30), 2**40):
+        with pytest.raises(TypeError):
+            m.i16_str(v)
+    for v in (-1, 2**16, -(2**30)):
+        with pytest.raises(TypeError):
+            m.u16_str(v)
+    for v in (2**30 - 1, 2**30, 2**31 - 1, -(2**30) + 1, -(2**30), -(2**31)):
+        assert m.i32_str(v) == str(v)
+    for v in (2**30 - 1, 2**30, 2**32 - 1):
+        assert m.u32_str(v) == str(v)
+    for v in (2**30 - 1, 2**30, 2**63 - 1, -(2**30), -(2**63)):
+        assert m.i64_str(v) == str(v)
+    assert m.u64_str(2**64 - 1) == str(2**64 - 1)
+    for v in (-(2**30) + 1, -(2**30), -(2**40)):
+        with pytest.raises(TypeError):
+            m.u64_str(v)
+
+    # int subclasses take the regular path.
+    class MyInt(int):
+        pass
+
+    assert m.i16_str(MyInt(7)) == "7"
+    with pytest.raises(TypeError):
+        m.i16_str(MyInt(2**15))
+
+
 def test_int_convert(doc):
     class Int:
         def __int__(self):
@@ -577,6 +577,22 @@ TEST_SUBMODULE(class_, m) {
         py::class_<OtherDuplicateNested>(gt, "YetAnotherDuplicateNested");
     });
 
+    // test_instance_sizeof, test_no_weakref
+    struct LargePayload {
+        char data[4096] = {};
+    };
+    struct CompactPayload {
+        int value = 0;
+    };
+    py::class_<LargePayload>(m, "LargePayload").def(py::init<>());
+#if PYBIND11_INTERNALS_VERSION >= 12
+    py::class_<CompactPayload>(m, "CompactPayload", py::no_weakref())
+        .def(py::init<>())
+        .def_readwrite("value", &CompactPayload::value);
+#endif
+    m.attr("sizeof_LargePayload") = sizeof(LargePayload);
+    m.attr("PYBIND11_INTERNALS_VERSION") = PYBIND11_INTERNALS_VERSION;
+
     test_class::pr4220_tripped_over_this::bind_empty0(m);
 }
 
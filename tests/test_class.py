@@ -1,6 +1,7 @@
 from __future__ import annotations
 
 import sys
+import weakref
 from unittest import mock
 
 import pytest
@@ -555,3 +556,35 @@ def test_all_type_info_multithreaded():
 
         for thread in threads:
             thread.join()
+
+
+@pytest.mark.skipif("env.PYPY", reason="PyPy does not report CPython object sizes")
+def test_instance_sizeof():
+    obj = m.LargePayload()
+    assert obj.__sizeof__() == type(obj).__basicsize__ + m.sizeof_LargePayload
+    assert sys.getsizeof(obj) >= m.sizeof_LargePayload
+
+
+def test_weakref_by_default():
+    obj = m.LargePayload()
+    assert weakref.ref(obj)() is obj
+
+
+@pytest.mark.skipif(
+    m.PYBIND11_INTERNALS_VERSION < 12, reason="py::no_weakref() requires ABI version 12"
+)
+def test_no_weakref():
+    compact = m.CompactPayload()
+    assert m.CompactPayload.__weakrefoffset__ == 0
+    assert m.CompactPayload.__basicsize__ < m.LargePayload.__basicsize__
+    with pytest.raises(TypeError):
+        weakref.ref(compact)
+
+    # Python subclasses get a weak reference list regardless.
+    class PyCompactPayload(m.CompactPayload):
+        pass
+
+    derived = PyCompactPayload()
+    assert weakref.ref(derived)() is derived
+    derived.value = 3
+    assert derived.value == 3
@@ -2,7 +2,11 @@
 
 #include "pybind11_tests.h"
 
+#include <atomic>
+#include <chrono>
+#include <mutex>
 #include <string>
+#include <thread>
 #include <unordered_map>
 
 namespace pybind11_tests {
@@ -15,6 +19,12 @@ static RegistryType &PyGILState_Check_Results() {
     return singleton;
 }
 
+// ProbeType<2> and ProbeType<3> are destroyed on the deferred destruction worker thread.
+static std::mutex &RegistryMutex() {
+    static std::mutex singleton;
+    return singleton;
+}
+
 template <int> // Using int as a trick to easily generate a series of types.
 struct ProbeType {
 private:
@@ -25,12 +35,27 @@ public:
     ProbeType(const ProbeType &) = default;
 
     ~ProbeType() {
+        std::lock_guard<std::mutex> lock(RegistryMutex());
         RegistryType &reg = PyGILState_Check_Results();
         assert(reg.count(unique_key) == 0);
         reg[unique_key] = PyGILState_Check();
     }
 };
 
+// Occupies the deferred destruction worker thread until released, so that destructor calls
+// queued behind it are still queued when the test forks.
+static std::atomic<bool> blocking_probe_hold{false};
+static std::atomic<bool> blocking_probe_started{false};
+
+struct BlockingProbe {
+    ~BlockingProbe() {
+        blocking_probe_started = true;
+        while (blocking_probe_hold) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+    }
+};
+
 } // namespace class_release_gil_before_calling_cpp_dtor
 } // namespace pybind11_tests
 
@@ -42,7 +67,27 @@ TEST_SUBMODULE(class_release_gil_before_calling_cpp_dtor, m) {
     py::class_<ProbeType<1>>(m, "ProbeType1", py::release_gil_before_calling_cpp_dtor())
         .def(py::init<std::string>());
 
+    py::class_<ProbeType<2>>(m, "ProbeType2", py::deferred_cpp_dtor())
+        .def(py::init<std::string>());
+
+    py::classh<ProbeType<3>>(m, "ProbeType3", py::deferred_cpp_dtor())
+        .def(py::init<std::string>());
+
+    py::class_<BlockingProbe>(m, "BlockingProbe", py::deferred_cpp_dtor()).def(py::init<>());
+    m.def("hold_blocking_probe", [](bool hold) {
+        blocking_probe_hold = hold;
+        blocking_probe_started = false;
+    });
+    m.def("blocking_probe_started", []() -> bool { return blocking_probe_started; });
+
+    m.def("flush_deferred_cpp_dtors",
+          &py::flush_deferred_cpp_dtors,
+          py::call_guard<py::gil_scoped_release>());
+    m.def("deferred_cpp_dtors_pending", &py::deferred_cpp_dtors_pending);
+    m.def("set_deferred_cpp_dtor_queue_capacity", &py::set_deferred_cpp_dtor_queue_capacity);
+
     m.def("PopPyGILState_Check_Result", [](const std::string &unique_key) -> std::string {
+        std::lock_guard<std::mutex> lock(RegistryMutex());
         RegistryType &reg = PyGILState_Check_Results();
         if (reg.count(unique_key) == 0) {
             return "MISSING";
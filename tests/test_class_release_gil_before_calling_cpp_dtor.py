@@ -1,6 +1,10 @@
 from __future__ import annotations
 
 import gc
+import multiprocessing
+import os
+import signal
+import time
 
 import pytest
 
@@ -12,10 +16,121 @@ from pybind11_tests import class_release_gil_before_calling_cpp_dtor as m
     [
         (m.ProbeType0, "without_manipulating_gil", "1"),
         (m.ProbeType1, "release_gil_before_calling_cpp_dtor", "0"),
+        (m.ProbeType2, "deferred_cpp_dtor", "0"),
+        (m.ProbeType3, "deferred_cpp_dtor_smart_holder", "0"),
     ],
 )
 def test_gil_state_check_results(probe_type, unique_key, expected_result):
     probe_type(unique_key)
     gc.collect()
+    m.flush_deferred_cpp_dtors()
+    assert m.deferred_cpp_dtors_pending() == 0
     result = m.PopPyGILState_Check_Result(unique_key)
     assert result == expected_result
+
+
+def test_deferred_cpp_dtor_queue_full():
+    m.set_deferred_cpp_dtor_queue_capacity(0)
+    try:
+        m.ProbeType2("deferred_cpp_dtor_queue_full")
+        gc.collect()
+        # Not queued: the destructor ran synchronously, with the GIL held.
+        result = m.PopPyGILState_Check_Result("deferred_cpp_dtor_queue_full")
+    finally:
+        m.set_deferred_cpp_dtor_queue_capacity(1024)
+    assert result == "1"
+
+
+def test_deferred_cpp_dtor_many():
+    keys = [f"deferred_cpp_dtor_many_{i}" for i in range(100)]
+    for key in keys:
+        m.ProbeType2(key)
+    gc.collect()
+    m.flush_deferred_cpp_dtors()
+    assert [m.PopPyGILState_Check_Result(key) for key in keys] == ["0"] * len(keys)
+
+
+# fork() after starting threads can deadlock (see tests/conftest.py): the tests below fork
+# from a fresh process started by `multiprocessing` (forkserver on Linux), never from the
+# pytest process itself, which runs the worker thread of the destructor queue.
+
+
+def _fork_and_wait(child):
+    """Runs ``child()`` in a forked process and returns its exit status, or None on timeout."""
+    pid = os.fork()
+    if pid == 0:  # pragma: no cover
+        exit_code = 1
+        try:
+            if child():
+                exit_code = 0
+        finally:
+            os._exit(exit_code)
+    deadline = time.monotonic() + 10
+    while True:
+        waited_pid, status = os.waitpid(pid, os.WNOHANG)
+        if waited_pid != 0:
+            return status
+        if time.monotonic() > deadline:
+            os.kill(pid, signal.SIGKILL)
+            os.waitpid(pid, 0)
+            return None
+        time.sleep(0.01)
+
+
+def _deferred_cpp_dtor_after_fork():
+    m.ProbeType2("deferred_cpp_dtor_before_fork")  # Ensures the worker thread is running.
+    m.flush_deferred_cpp_dtors()
+    assert m.PopPyGILState_Check_Result("deferred_cpp_dtor_before_fork") == "0"
+
+    def child():
+        m.ProbeType2("deferred_cpp_dtor_after_fork")
+        gc.collect()
+        m.flush_deferred_cpp_dtors()
+        return m.PopPyGILState_Check_Result("deferred_cpp_dtor_after_fork") == "0"
+
+    status = _fork_and_wait(child)
+    assert status is not None, "flush_deferred_cpp_dtors() hangs in the forked child"
+    assert os.WIFEXITED(status)
+    assert os.WEXITSTATUS(status) == 0
+
+
+def _deferred_cpp_dtor_fork_with_queued_dtors():
+    m.hold_blocking_probe(True)
+    try:
+        m.BlockingProbe()  # Occupies the worker thread ...
+        deadline = time.monotonic() + 10
+        while not m.blocking_probe_started():
+            assert time.monotonic() < deadline
+            time.sleep(0.001)
+        m.ProbeType2("deferred_cpp_dtor_queued_at_fork")  # ... so that this stays queued.
+        gc.collect()
+        assert m.deferred_cpp_dtors_pending() == 2
+
+        def child():
+            # The worker thread was not forked, the queued destructor call must still run.
+            m.flush_deferred_cpp_dtors()
+            return m.PopPyGILState_Check_Result("deferred_cpp_dtor_queued_at_fork") == "0"
+
+        status = _fork_and_wait(child)
+    finally:
+        m.hold_blocking_probe(False)
+    assert status is not None, "flush_deferred_cpp_dtors() hangs in the forked child"
+    assert os.WIFEXITED(status)
+    assert os.WEXITSTATUS(status) == 0
+    m.flush_deferred_cpp_dtors()
+    assert m.PopPyGILState_Check_Result("deferred_cpp_dtor_queued_at_fork") == "0"
+
+
+@pytest.mark.skipif(not hasattr(os, "fork"), reason="requires os.fork()")
+@pytest.mark.parametrize(
+    "target", [_deferred_cpp_dtor_after_fork, _deferred_cpp_dtor_fork_with_queued_dtors]
+)
+def test_deferred_cpp_dtor_fork(target):
+    process = multiprocessing.Process(target=target)
+    process.daemon = True
+    process.start()
+    process.join(timeout=30)
+    if process.is_alive():
+        process.terminate()
+        pytest.fail("DEADLOCK in the process forking with deferred destructor calls")
+    assert process.exitcode == 0
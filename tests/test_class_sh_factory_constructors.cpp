@@ -67,6 +67,41 @@ struct with_alias {
 struct with_alias_alias : with_alias, py::trampoline_self_life_support {};
 struct sddwaa : std::default_delete<with_alias_alias> {};
 
+// py::init_shared<...>(): std::make_shared bypasses the class-specific operator new.
+template <int SerNo>
+struct counted_new {
+    int val = 0;
+    counted_new() = default;
+    explicit counted_new(int v) : val(v) {}
+    static int new_count;
+    static void *operator new(std::size_t sz) {
+        ++new_count;
+        return ::operator new(sz);
+    }
+    static void operator delete(void *ptr) { ::operator delete(ptr); }
+};
+template <int SerNo>
+int counted_new<SerNo>::new_count = 0;
+
+using counted_new_smhld = counted_new<0>;
+using counted_new_shptr = counted_new<1>;
+
+struct shared_with_alias {
+    int val = 0;
+    shared_with_alias() = default;
+    explicit shared_with_alias(int v) : val(v) {}
+    virtual ~shared_with_alias() = default;
+    shared_with_alias(const shared_with_alias &) = default;
+    shared_with_alias(shared_with_alias &&) = default;
+    shared_with_alias &operator=(const shared_with_alias &) = default;
+    shared_with_alias &operator=(shared_with_alias &&) = default;
+    virtual int get() const { return val; }
+};
+struct shared_with_alias_alias : shared_with_alias, py::trampoline_self_life_support {
+    using shared_with_alias::shared_with_alias;
+    int get() const override { PYBIND11_OVERRIDE(int, shared_with_alias, get); }
+};
+
 } // namespace class_sh_factory_constructors
 } // namespace pybind11_tests
 
@@ -153,4 +188,30 @@ TEST_SUBMODULE(class_sh_factory_constructors, m) {
                       [](int, int, int, int, int) {
                           return std::make_shared<with_alias>(); // Invalid alias factory.
                       }));
+
+    py::classh<atyp<0xC>>(m, "atyp_shin")
+        .def(py::init_shared<std::string>())
+        .def("get_mtxt", get_mtxt<atyp<0xC>>);
+
+    py::classh<counted_new_smhld>(m, "counted_new_smhld")
+        .def(py::init<>())
+        .def(py::init_shared<int>())
+        .def_readonly("val", &counted_new_smhld::val)
+        .def_readonly_static("new_count", &counted_new_smhld::new_count);
+    m.def("pass_counted_new_smhld_shared_ptr",
+          [](const std::shared_ptr<counted_new_smhld> &ptr) { return ptr->val; });
+    m.def("pass_counted_new_smhld_unique_ptr",
+          [](std::unique_ptr<counted_new_smhld> ptr) { return ptr->val; });
+
+    py::class_<counted_new_shptr, std::shared_ptr<counted_new_shptr>>(m, "counted_new_shptr")
+        .def(py::init<>())
+        .def(py::init_shared<int>())
+        .def_readonly("val", &counted_new_shptr::val)
+        .def_readonly_static("new_count", &counted_new_shptr::new_count);
+
+    py::classh<shared_with_alias, shared_with_alias_alias>(m, "shared_with_alias")
+        .def(py::init_shared<int>())
+        .def("get", &shared_with_alias::get);
+    m.def("call_shared_with_alias_get",
+          [](const std::shared_ptr<shared_with_alias> &ptr) { return ptr->get(); });
 }
@@ -51,3 +51,36 @@ def test_with_alias_invalid(num_init_args, smart_ptr):
         + smart_ptr
         + " pointee is not an alias instance"
     )
+
+
+def test_init_shared_aggregate():
+    assert m.atyp_shin("Shin").get_mtxt() == "Shin"
+
+
+@pytest.mark.parametrize("cls", [m.counted_new_smhld, m.counted_new_shptr])
+def test_init_shared_single_allocation(cls):
+    new_count = cls.new_count
+    assert cls().val == 0
+    assert cls.new_count == new_count + 1
+    assert cls(7).val == 7
+    assert cls.new_count == new_count + 1  # Allocated by std::make_shared.
+
+
+def test_init_shared_ownership():
+    obj = m.counted_new_smhld(5)
+    assert m.pass_counted_new_smhld_shared_ptr(obj) == 5
+    with pytest.raises(ValueError) as excinfo:
+        m.pass_counted_new_smhld_unique_ptr(obj)
+    assert str(excinfo.value) == (
+        "Cannot disown external shared_ptr (load_as_unique_ptr)."
+    )
+    assert obj.val == 5
+
+
+def test_init_shared_with_alias():
+    class PyDrvd(m.shared_with_alias):
+        def get(self):
+            return 100 + super().get()
+
+    assert m.call_shared_with_alias_get(m.shared_with_alias(3)) == 3
+    assert m.call_shared_with_alias_get(PyDrvd(4)) == 104
@@ -0,0 +1,82 @@
+/*
+    tests/test_dlpack.cpp -- zero-copy tensor exchange through the DLPack protocol
+
+    Copyright (c) 2025 The Pybind Development Team.
+
+    All rights reserved. Use of this source code is governed by a
+    BSD-style license that can be found in the LICENSE file.
+*/
+
+#include <pybind11/dlpack.h>
+#include <pybind11/stl.h>
+
+#include "pybind11_tests.h"
+
+#include <cstdint>
+#include <memory>
+#include <utility>
+#include <vector>
+
+namespace {
+
+// Sum of the elements of a tensor of any number of dimensions.
+double sum(const py::dlpack_tensor<const double> &t, size_t dim, const double *ptr) {
+    if (dim == static_cast<size_t>(t.ndim())) {
+        return *ptr;
+    }
+    double total = 0;
+    auto d = static_cast<py::ssize_t>(dim);
+    for (py::ssize_t i = 0; i < t.shape(d); ++i) {
+        total += sum(t, dim + 1, ptr + i * t.strides(d));
+    }
+    return total;
+}
+
+int freed_count = 0;
+
+} // namespace
+
+TEST_SUBMODULE(dlpack, m) {
+    m.def("sum", [](const py::dlpack_tensor<const double> &t) { return sum(t, 0, t.data()); });
+    m.def("describe", [](const py::dlpack_tensor<const double> &t) {
+        return py::make_tuple(reinterpret_cast<std::uintptr_t>(t.data()),
+                              py::tuple(py::cast(t.shape())),
+                              py::tuple(py::cast(t.strides())));
+    });
+    m.def("fill_2d", [](const py::dlpack_tensor<float> &t, float value) {
+        for (py::ssize_t i = 0; i < t.shape(0); ++i) {
+            for (py::ssize_t j = 0; j < t.shape(1); ++j) {
+                t(i, j) = value;
+            }
+        }
+    });
+    m.def("int_sum", [](const py::dlpack_tensor<const std::int32_t> &t) {
+        std::int64_t total = 0;
+        for (py::ssize_t i = 0; i < t.shape(0); ++i) {
+            total += t(i);
+        }
+        return total;
+    });
+
+    m.def("arange", [](py::ssize_t rows, py::ssize_t cols) {
+        std::vector<double> values(static_cast<size_t>(rows * cols));
+        for (size_t i = 0; i < values.size(); ++i) {
+            values[i] = static_cast<double>(i);
+        }
+        return py::dlpack_tensor<double>(std::move(values), {rows, cols});
+    });
+    m.def("const_column", []() {
+        static const std::int32_t values[] = {1, 2, 3, 4, 5, 6};
+        // Every other element, without an owner as the data is static.
+        return py::dlpack_tensor<const std::int32_t>(values, {3}, {2});
+    });
+    m.def("tracked", []() {
+        std::shared_ptr<std::vector<double>> storage(new std::vector<double>(4, 1.0),
+                                                     [](std::vector<double> *v) {
+                                                         ++freed_count;
+                                                         delete v;
+                                                     });
+        return py::dlpack_tensor<double>(storage->data(), {4}, {}, storage);
+    });
+    m.def("freed_count", []() { return freed_count; });
+}
@@ -0,0 +1,103 @@
+from __future__ import annotations
+
+import gc
+
+import pytest
+
+from pybind11_tests import dlpack as m
+
+np = pytest.importorskip("numpy")
+
+# Read-only tensors are exported by NumPy 2.1+ (DLPack 1.0).
+dlpack_versioned = np.lib.NumpyVersion(np.__version__) >= "2.1.0"
+
+
+def test_import_numpy():
+    x = np.arange(24.0).reshape(2, 3, 4)
+    assert m.sum(x) == x.sum()
+    assert m.sum(x[:, ::-2, 1:]) == x[:, ::-2, 1:].sum()
+    assert m.sum(x.T) == x.sum()
+    assert m.sum(np.array(2.5)) == 2.5
+
+    address, shape, strides = m.describe(x[:, 1:, ::2])
+    assert address == x[:, 1:, ::2].ctypes.data
+    assert shape == (2, 2, 2)
+    assert strides == (12, 4, 2)
+
+    assert m.int_sum(np.arange(5, dtype="int32")) == 10
+
+    # Writes go to the original array.
+    y = np.zeros((3, 4), dtype="float32")
+    m.fill_2d(y[::2, 1:], 7)
+    np.testing.assert_array_equal(y[::2, 1:], 7)
+    assert not y[1].any()
+    assert not y[:, 0].any()
+
+
+def test_import_rejected():
+    with pytest.raises(TypeError):
+        m.sum(np.arange(3, dtype="float32"))
+    with pytest.raises(TypeError):
+        m.int_sum(np.arange(3, dtype="int64"))
+    with pytest.raises(TypeError):
+        m.sum([1.0, 2.0])
+    y = np.zeros((2, 2), dtype="float32")
+    y.flags.writeable = False
+    with pytest.raises(TypeError):
+        m.fill_2d(y, 1)
+    if dlpack_versioned:
+        # Read-only arrays are still accepted as `const` tensors.
+        assert m.sum(np.broadcast_to(np.float64(2), (3,))) == 6
+
+
+def test_export():
+    t = m.arange(3, 4)
+    assert t.__dlpack_device__() == (1, 0)
+    x = np.from_dlpack(t)
+    np.testing.assert_array_equal(x, np.arange(12.0).reshape(3, 4))
+    assert x.flags.writeable
+    # Zero-copy: every array shares the tensor's memory, which outlives the tensor object.
+    y = np.from_dlpack(t)
+    del t
+    gc.collect()
+    y[0, 0] = 42
+    assert x[0, 0] == 42
+
+    c = np.from_dlpack(m.const_column())
+    np.testing.assert_array_equal(c, [1, 3, 5])
+    if dlpack_versioned:
+        assert not c.flags.writeable
+
+    # Round trip through C++.
+    assert m.sum(m.arange(2, 2)) == 6
+
+
+def test_capsules():
+    t = m.arange(1, 2)
+    assert "dltensor_versioned" in repr(t.__dlpack__(max_version=(1, 0)))
+    assert '"dltensor"' in repr(t.__dlpack__())
+    assert '"dltensor"' in repr(t.__dlpack__(max_version=(0, 8)))
+    capsule = t.__dlpack__(dl_device=(1, 0), copy=False, max_version=(1, 3))
+    assert "dltensor_versioned" in repr(capsule)
+
+    with pytest.raises(BufferError, match="stream"):
+        t.__dlpack__(stream=1)
+    with pytest.raises(BufferError, match="CPU"):
+        t.__dlpack__(dl_device=(2, 0))
+    with pytest.raises(BufferError, match="copy"):
+        t.__dlpack__(copy=True)
+    with pytest.raises(BufferError, match="read-only"):
+        m.const_column().__dlpack__()
+
+
+def test_capsule_lifetime():
+    before = m.freed_count()
+    t = m.tracked()
+    capsules = [t.__dlpack__(), t.__dlpack__(max_version=(1, 0))]
+    x = np.from_dlpack(t)
+    del t, capsules
+    gc.collect()
+    assert m.freed_count() == before
+    del x
+    gc.collect()
+    assert m.freed_count() == before + 1
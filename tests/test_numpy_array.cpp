@@ -13,6 +13,8 @@
 #include "pybind11_tests.h"
 
 #include <cstdint>
+#include <memory>
+#include <numeric>
 #include <utility>
 
 // Size / dtype checks.
@@ -508,6 +510,53 @@ TEST_SUBMODULE(numpy_array, sm) {
     sm.def("array_view",
            [](py::array_t<uint8_t> a, const std::string &dtype) { return a.view(dtype); });
 
+    // test_as_ndarray
+    sm.def("as_ndarray_vector",
+           [](py::ssize_t n, const std::vector<py::ssize_t> &shape,
+              const std::vector<py::ssize_t> &strides) {
+               std::vector<double> values(static_cast<size_t>(n));
+               std::iota(values.begin(), values.end(), 0.0);
+               const double *data = values.data();
+               auto a = py::as_ndarray(std::move(values), shape, strides);
+               return py::make_tuple(a, a.data() == data);
+           });
+    sm.def("as_ndarray_unique_ptr", [](py::ssize_t rows, py::ssize_t cols) {
+        std::unique_ptr<std::int32_t[]> values(new std::int32_t[static_cast<size_t>(rows * cols)]);
+        for (py::ssize_t i = 0; i < rows * cols; ++i) {
+            values[static_cast<size_t>(i)] = static_cast<std::int32_t>(i);
+        }
+        // Fortran order.
+        return py::as_ndarray(std::move(values),
+                              {rows, cols},
+                              {py::ssize_t{4}, static_cast<py::ssize_t>(4 * rows)});
+    });
+
+    // test_array_allocators
+    sm.def("aligned_array", [](size_t alignment, py::ssize_t n) {
+        return py::array_t<double>({n}, py::aligned_allocator(alignment));
+    });
+    sm.def("aligned_f_array", [](py::ssize_t rows, py::ssize_t cols) {
+        return py::array_t<float, py::array::f_style>({rows, cols}, py::aligned_allocator());
+    });
+    sm.def("huge_page_array", [](py::ssize_t n) {
+        return py::array_t<std::uint8_t>({n}, py::huge_page_allocator());
+    });
+    sm.def("arena_arrays", [](const std::vector<py::ssize_t> &sizes) {
+        py::array_arena arena(1024);
+        py::list arrays;
+        for (auto n : sizes) {
+            py::array_t<std::int32_t> a({n}, arena);
+            std::fill(a.mutable_data(), a.mutable_data() + n, static_cast<std::int32_t>(n));
+            arrays.append(a);
+        }
+        return py::make_tuple(arrays, arena.bytes_reserved());
+    });
+    sm.def("call_with_aligned_numpy", [](size_t alignment, const py::function &f) {
+        py::scoped_array_allocator<py::aligned_allocator> scope(py::aligned_allocator(alignment),
+                                                                "pybind11_test_allocator");
+        return f();
+    });
+
     sm.def("reshape_initializer_list",
            [](py::array_t<int> a, size_t N, size_t M, size_t O) { return a.reshape({N, M, O}); });
     sm.def("reshape_tuple", [](py::array_t<int> a, const std::vector<int> &new_shape) {
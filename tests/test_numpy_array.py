@@ -489,12 +489,112 @@ def test_array_view():
     assert a_int16_view.shape == (100 * 2,)
 
 
+@pytest.mark.parametrize(
+    ("n", "shape", "strides", "expected"),
+    [
+        (5, [], [], np.arange(5.0)),
+        (0, [], [], np.zeros(0)),
+        (6, [2, 3], [], np.arange(6.0).reshape(2, 3)),
+        (6, [3, 2], [8, 24], np.arange(6.0).reshape(2, 3).T),
+        (6, [3], [16], [0.0, 2.0, 4.0]),
+        (6, [2, 2], [0, 8], [[0.0, 1.0], [0.0, 1.0]]),
+        (2, [4, 0], [], np.zeros((4, 0))),
+    ],
+)
+def test_as_ndarray(n, shape, strides, expected):
+    a, zero_copy = m.as_ndarray_vector(n, shape, strides)
+    np.testing.assert_array_equal(a, expected)
+    assert a.shape == np.shape(expected)
+    assert a.flags.writeable
+    if n > 0:
+        assert zero_copy
+        assert type(a.base).__name__ == "PyCapsule"
+    a[...] = 1
+    del a
+
+
+@pytest.mark.parametrize(
+    ("n", "shape", "strides"),
+    [(5, [6], []), (6, [2, 3], [32, 8]), (6, [3], [-8]), (6, [-1], [])],
+)
+def test_as_ndarray_out_of_bounds(n, shape, strides):
+    with pytest.raises(ValueError, match="as_ndarray"):
+        m.as_ndarray_vector(n, shape, strides)
+
+
+def test_as_ndarray_unique_ptr():
+    a = m.as_ndarray_unique_ptr(2, 3)
+    np.testing.assert_array_equal(a, np.arange(6).reshape(3, 2).T)
+    assert a.dtype == np.int32
+    assert a.flags.f_contiguous
+    assert type(a.base).__name__ == "PyCapsule"
+
+
 def test_array_view_invalid():
     a = np.ones(100 * 4).astype("uint8")
     with pytest.raises(TypeError):
         m.array_view(a, "deadly_dtype")
 
 
+@pytest.mark.parametrize("alignment", [8, 64, 4096])
+def test_aligned_allocator(alignment):
+    a = m.aligned_array(alignment, 1000)
+    assert a.shape == (1000,)
+    assert a.ctypes.data % alignment == 0
+    assert a.flags.writeable
+    assert type(a.base).__name__ == "PyCapsule"
+    a[:] = 1
+    assert a.sum() == 1000
+    assert m.aligned_array(alignment, 0).shape == (0,)
+
+    f = m.aligned_f_array(3, 5)
+    assert f.flags.f_contiguous
+    assert f.ctypes.data % 64 == 0
+
+    with pytest.raises(ValueError, match="power of two"):
+        m.aligned_array(24, 1)
+
+
+def test_huge_page_allocator():
+    a = m.huge_page_array(3 << 20)
+    assert a.ctypes.data % (2 << 20) == 0
+    a[:] = 7
+    assert a[-1] == 7
+
+
+def test_array_arena():
+    arrays, reserved = m.arena_arrays([10, 100, 1000])
+    # The first two arrays share a 1024-byte block, each 64-byte aligned, the third one does not
+    # fit and gets its own block.
+    assert arrays[1].ctypes.data == arrays[0].ctypes.data + 64
+    assert reserved == 1024 + 4032
+    # The arena is kept alive by the arrays.
+    for a in arrays:
+        assert a.ctypes.data % 64 == 0
+        assert (a == a.size).all()
+
+
+def test_scoped_array_allocator():
+    multiarray = (getattr(np, "_core", None) or np.core).multiarray
+    if not hasattr(multiarray, "get_handler_name"):
+        pytest.skip("requires NumPy >= 1.22")
+
+    def allocate():
+        a = np.empty(1000)
+        a.resize(5000, refcheck=False)
+        b = np.zeros(500)
+        return [a, b, b + 1]
+
+    arrays = m.call_with_aligned_numpy(4096, allocate)
+    for a in arrays:
+        assert a.ctypes.data % 4096 == 0
+        assert multiarray.get_handler_name(a) == "pybind11_test_allocator"
+    assert arrays[0].size == 5000
+    assert not arrays[1].any()
+    assert (arrays[2] == 1).all()
+    assert multiarray.get_handler_name(np.empty(1000)) != "pybind11_test_allocator"
+
+
 def test_reshape_initializer_list():
     a = np.arange(2 * 7 * 3) + 1
     x = m.reshape_initializer_list(a, 2, 7, 3)
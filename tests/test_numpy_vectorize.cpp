@@ -12,7 +12,17 @@
 
 #include "pybind11_tests.h"
 
+#include <cmath>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <mutex>
+#include <set>
+#include <stdexcept>
+#include <string>
+#include <thread>
 #include <utility>
+#include <vector>
 
 double my_func(int x, float y, double z) {
     py::print("my_func(x:int={}, y:float={:.0f}, z:float={:.0f})"_s.format(x, y, z));
@@ -104,4 +114,136 @@ TEST_SUBMODULE(numpy_vectorize, m) {
           });
 
     m.def("add_to", py::vectorize([](NonPODClass &x, int a) { x.value += a; }));
+
+    // test_parallel_vectorize
+    m.def("parallel_func",
+          py::vectorize([](int x, float y, double z) { return (double) x * y + z; },
+                        py::parallel(4, 1)));
+    m.def("parallel_gil_held",
+          py::vectorize([](int) { return PyGILState_Check() != 0; }, py::parallel(4, 1)));
+    m.def("parallel_gil_held_large_chunks",
+          py::vectorize([](int) { return PyGILState_Check() != 0; }, py::parallel(4)));
+    m.def("parallel_throw", py::vectorize(
+                                [](int x) {
+                                    if (x == 13) {
+                                        throw std::out_of_range("13");
+                                    }
+                                    return x;
+                                },
+                                py::parallel(4, 1)));
+    vtc.def("parallel_method", py::vectorize(&VectorizeTestClass::method, py::parallel(3, 1)));
+
+    // test_vectorize_out
+    m.def("add_out",
+          py::vectorize([](double x, double y) { return x + y; }).with_out(),
+          py::arg("x"),
+          py::arg("y"),
+          py::arg("out") = py::none());
+    m.def("parallel_add_out",
+          py::vectorize([](double x, double y) { return x + y; }, py::parallel(4, 1)).with_out(),
+          py::arg("x"),
+          py::arg("y"),
+          py::arg("out") = py::none());
+
+    // test_vectorize_block
+    static std::vector<size_t> block_sizes;
+    m.def("block_add",
+          py::vectorize_block([](const double *a, const float *b, double *out, size_t n) {
+              block_sizes.push_back(n);
+              for (size_t i = 0; i < n; ++i) {
+                  out[i] = a[i] + 2 * b[i];
+              }
+          }));
+    m.def("block_sizes", []() {
+        py::list sizes;
+        for (auto n : block_sizes) {
+            sizes.append(n);
+        }
+        block_sizes.clear();
+        return sizes;
+    });
+
+    // test_vectorize_reduce
+    auto sum_squares = [](double acc, double x) { return acc + x * x; };
+    m.def("reduce_sum_squares",
+          py::vectorize_reduce(0.0, sum_squares),
+          py::arg("x"),
+          py::arg("axis") = py::none(),
+          py::arg("keepdims") = false);
+    m.def("parallel_reduce_sum_squares",
+          py::vectorize_reduce(0.0, sum_squares, py::parallel(4, 1)),
+          py::arg("x"),
+          py::arg("axis") = py::none(),
+          py::arg("keepdims") = false);
+    // The index of the first maximum
+    struct ArgMax {
+        double value;
+        py::ssize_t index;
+    };
+    m.def("reduce_argmax",
+          py::vectorize_reduce(
+              ArgMax{-std::numeric_limits<double>::infinity(), -1},
+              [](ArgMax acc, double x, py::ssize_t index) {
+                  return x > acc.value || acc.index < 0 ? ArgMax{x, index} : acc;
+              },
+              [](const ArgMax &acc) { return acc.index; }),
+          py::arg("x"),
+          py::arg("axis") = py::none(),
+          py::arg("keepdims") = false);
+    m.def("reduce_mean",
+          py::vectorize_reduce(
+              std::make_pair(0.0, 0),
+              [](std::pair<double, int> acc, float x) {
+                  return std::make_pair(acc.first + x, acc.second + 1);
+              },
+              [](const std::pair<double, int> &acc) { return acc.first / acc.second; },
+              py::parallel(2, 1)),
+          py::arg("x"),
+          py::arg("axis") = py::none(),
+          py::arg("keepdims") = false);
+    m.def("reduce_any",
+          py::vectorize_reduce(false, [](bool acc, double x) { return acc || x != 0; }),
+          py::arg("x"),
+          py::arg("axis") = py::none(),
+          py::arg("keepdims") = false);
+    m.def("parallel_reduce_all",
+          py::vectorize_reduce(
+              true, [](bool acc, double x) { return acc && x != 0; }, py::parallel(4, 1)),
+          py::arg("x"),
+          py::arg("axis") = py::none(),
+          py::arg("keepdims") = false);
+
+    // The number of threads running the combine step of a reduction.
+    static std::mutex reduce_threads_mutex;
+    static std::set<std::thread::id> reduce_threads;
+    m.def("parallel_reduce_threads", [](const py::array_t<double> &x, const py::object &axis) {
+        static auto reduce = py::vectorize_reduce(
+            0.0,
+            [](double acc, double value) {
+                std::lock_guard<std::mutex> lock(reduce_threads_mutex);
+                reduce_threads.insert(std::this_thread::get_id());
+                return acc + value;
+            },
+            py::parallel(4, 1));
+        reduce_threads.clear();
+        reduce(x, axis, false);
+        return reduce_threads.size();
+    });
+
+    // test_ufunc
+    py::ufunc(m, "ufunc_add", "Adds two arrays.", py::ufunc_identity::zero)
+        .def<std::int64_t(std::int64_t, std::int64_t)>(std::plus<std::int64_t>())
+        .def([](float a, float b) { return a + b; })
+        .def<double(double, double)>(std::plus<double>());
+    py::ufunc(m, "ufunc_checked_sqrt").def([](double x) {
+        if (x < 0) {
+            throw std::domain_error("negative value: " + std::to_string(x));
+        }
+        return std::sqrt(x);
+    });
+    m.def("ufunc_mismatched_def", [](const py::module_ &scope) {
+        py::ufunc(scope, "ufunc_mismatched")
+            .def([](double x) { return x; })
+            .def([](float x, float y) { return x * y; });
+    });
 }
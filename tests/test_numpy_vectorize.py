@@ -266,3 +266,282 @@ def test_vectorized_noreturn():
     assert x.value == 11
     m.add_to(x, [[1, 1], [2, 3]])
     assert x.value == 18
+
+
+def test_parallel_vectorize():
+    x = np.arange(1000, dtype="int32")
+    y = np.linspace(0, 1, 1000, dtype="float32")
+    expected = x * y.astype("float64") + 2
+    # Trivial (contiguous) inputs, split into index ranges.
+    np.testing.assert_allclose(m.parallel_func(x, y, 2), expected)
+    # Non-trivial broadcasts, split along the outermost dimension.
+    z = np.arange(7, dtype="float64").reshape(7, 1)
+    np.testing.assert_allclose(
+        m.parallel_func(x[::2], y[::2], z), x[::2] * y[::2].astype("float64") + z
+    )
+    np.testing.assert_allclose(
+        m.parallel_func(x.reshape(10, 100).T, 1, 0), x.reshape(10, 100).T
+    )
+    assert m.parallel_func(np.array([], dtype="int32"), 1, 2).shape == (0,)
+    assert m.parallel_func(3, 2, 1) == 7
+
+    # The GIL is released while running on multiple threads.
+    assert not m.parallel_gil_held(x).any()
+    assert m.parallel_gil_held(np.arange(1)).all()
+    assert m.parallel_gil_held_large_chunks(x).all()
+
+    with pytest.raises(IndexError, match="13"):
+        m.parallel_throw(np.arange(100))
+
+    o = m.VectorizeTestClass(3)
+    np.testing.assert_allclose(
+        o.parallel_method(np.arange(5), np.arange(6, dtype="float32").reshape(6, 1)),
+        o.method(np.arange(5), np.arange(6, dtype="float32").reshape(6, 1)),
+    )
+
+
+def test_vectorize_out():
+    x = np.arange(12, dtype="float64").reshape(3, 4)
+    y = np.linspace(0, 1, 4)
+    expected = x + y
+    np.testing.assert_array_equal(m.add_out(x, y), expected)
+
+    out = np.empty_like(x)
+    assert m.add_out(x, y, out=out) is out
+    np.testing.assert_array_equal(out, expected)
+
+    # In place, aliasing an input
+    z = x.copy()
+    assert m.add_out(z, y, out=z) is z
+    np.testing.assert_array_equal(z, expected)
+    z = x.copy()
+    assert m.add_out(z, z, out=z) is z
+    np.testing.assert_array_equal(z, 2 * x)
+
+    # Non-contiguous out and partially overlapping inputs are written via a temporary
+    out = np.zeros((3, 8))
+    assert m.add_out(x, y, out[:, ::2]) is not None
+    np.testing.assert_array_equal(out[:, ::2], expected)
+    assert not out[:, 1::2].any()
+    z = np.arange(10, dtype="float64")
+    m.add_out(z[1:], 1, out=z[:-1])
+    np.testing.assert_array_equal(z, np.append(np.arange(2, 11), 9))
+    z = np.arange(10, dtype="float64")
+    m.add_out(z[:-1], 1, out=z[1:])
+    np.testing.assert_array_equal(z, np.append(0, np.arange(1, 10)))
+
+    # 0-d out
+    out = np.zeros(())
+    assert m.add_out(1, 2, out=out) is out
+    assert out == 3
+    assert m.add_out(1, 2) == 3
+
+    out = np.empty((0, 4))
+    assert m.add_out(np.empty((0, 4)), 1, out=out) is out
+
+    with pytest.raises(ValueError, match="shape"):
+        m.add_out(x, y, out=np.empty(12))
+    with pytest.raises(TypeError, match="dtype"):
+        m.add_out(x, y, out=np.empty((3, 4), dtype="float32"))
+    with pytest.raises(TypeError, match="dtype"):
+        m.add_out(x, y, out=[0.0] * 12)
+    out = np.empty((3, 4))
+    out.flags.writeable = False
+    with pytest.raises(ValueError, match="read-only"):
+        m.add_out(x, y, out=out)
+
+    x = np.arange(1000, dtype="float64")
+    assert m.parallel_add_out(x, x, out=x) is x
+    np.testing.assert_array_equal(x, 2 * np.arange(1000))
+    out = np.empty((10, 100))
+    m.parallel_add_out(x.reshape(10, 100).T.T, np.ones((10, 1)), out=out)
+    np.testing.assert_array_equal(out, x.reshape(10, 100) + 1)
+
+
+@pytest.mark.parametrize(
+    ("x", "y"),
+    [
+        (np.arange(6.0).reshape(6, 1), np.arange(4.0).reshape(1, 4)),
+        (np.arange(24.0).reshape(2, 3, 4), np.arange(4.0)),
+        (np.arange(24.0).reshape(2, 3, 4), np.arange(3.0).reshape(3, 1)),
+        (np.arange(24.0).reshape(2, 1, 3, 4), np.arange(12.0).reshape(3, 1, 4)),
+        (np.arange(48.0).reshape(2, 3, 8)[:, :, ::2], np.arange(4.0)),
+        (np.arange(48.0).reshape(4, 3, 4)[:2], np.arange(4.0)),
+        (np.arange(24.0).reshape(2, 3, 4)[::-1, :, ::-1], np.arange(12.0).reshape(3, 4)),
+        (np.arange(24.0).reshape(4, 6).T, np.arange(4.0)),
+        (
+            np.arange(24.0).reshape(2, 3, 4).transpose(1, 0, 2),
+            np.arange(16.0).reshape(1, 2, 8)[..., ::2],
+        ),
+    ],
+)
+def test_broadcast_coalescing(x, y):
+    # Non-trivial broadcasts, whose dimensions are coalesced into runs as far as possible
+    np.testing.assert_array_equal(m.add_out(x, y), x + y)
+    np.testing.assert_array_equal(m.add_out(y, x), y + x)
+    np.testing.assert_array_equal(m.block_add(x, y), x + 2 * y)
+
+
+def test_vectorize_block():
+    def expected(a, b):
+        return np.asarray(a, dtype="float64") + 2 * np.asarray(b, dtype="float32")
+
+    m.block_sizes()
+    # Contiguous inputs: a single run, split into blocks of at most 1024 elements.
+    a = np.arange(2500, dtype="float64")
+    b = np.arange(2500, dtype="float32")
+    np.testing.assert_array_equal(m.block_add(a, b), expected(a, b))
+    assert m.block_sizes() == [1024, 1024, 452]
+    # Broadcast scalar, strided and Fortran-ordered inputs.
+    np.testing.assert_array_equal(m.block_add(a, 1), expected(a, 1))
+    np.testing.assert_array_equal(m.block_add(a[::-3], b[::3]), expected(a[::-3], b[::3]))
+    af = np.asfortranarray(a.reshape(50, 50))
+    bf = np.asfortranarray(b.reshape(50, 50))
+    np.testing.assert_array_equal(m.block_add(af, bf), expected(af, bf))
+    m.block_sizes()
+    # Non-trivial broadcasts: one run per index of the outer dimensions.
+    x = np.arange(3, dtype="float64").reshape(3, 1)
+    y = np.arange(4, dtype="float32").reshape(1, 4)
+    np.testing.assert_array_equal(m.block_add(x, y), expected(x, y))
+    np.testing.assert_array_equal(m.block_add(y, x), expected(y, x))
+    assert m.block_sizes() == [4, 4, 4, 4, 4, 4]
+    z = np.arange(24, dtype="float64").reshape(2, 3, 4)
+    w = np.arange(12, dtype="float32").reshape(3, 4)
+    m.block_sizes()
+    # The inner dimensions over which both inputs are contiguous are coalesced into one run.
+    np.testing.assert_array_equal(m.block_add(z, w), expected(z, w))
+    assert m.block_sizes() == [12, 12]
+    np.testing.assert_array_equal(m.block_add(z, y[0]), expected(z, y[0]))
+    np.testing.assert_array_equal(m.block_add(z[:, :, ::2], x), expected(z[:, :, ::2], x))
+
+    assert m.block_add(1, 2) == 5
+    assert m.block_add(np.zeros((0, 3)), 1).shape == (0, 3)
+    assert "numpy.typing.ArrayLike, numpy.float32]" in m.block_add.__doc__
+
+
+@pytest.mark.parametrize("func", [m.reduce_sum_squares, m.parallel_reduce_sum_squares])
+def test_vectorize_reduce(func):
+    x = np.arange(24.0).reshape(2, 3, 4)
+
+    def expected(a, **kwargs):
+        return np.sum(np.square(a), **kwargs)
+
+    assert func(x) == expected(x)
+    for a in [x, x.transpose(2, 0, 1), x[:, ::-1, ::2], np.asfortranarray(x)]:
+        for axis in [0, 1, 2, -1, (0, 2), (2, 0), (1,), (0, 1, 2), ()]:
+            for keepdims in [False, True]:
+                np.testing.assert_array_equal(
+                    func(a, axis=axis, keepdims=keepdims),
+                    expected(a, axis=axis, keepdims=keepdims),
+                )
+    assert func(x, keepdims=True).shape == (1, 1, 1)
+    assert func(x, axis=np.int64(1)).shape == (2, 4)
+    assert func([1, 2, 3]) == 14
+    assert func(3) == 9
+    np.testing.assert_array_equal(func(np.zeros((0, 3)), axis=0), [0, 0, 0])
+    assert func(np.zeros((0, 3)), axis=1).shape == (0,)
+
+    with pytest.raises(IndexError, match="axis 3 is out of bounds for array of dimension 3"):
+        func(x, axis=3)
+    with pytest.raises(IndexError, match="axis -4 is out of bounds"):
+        func(x, axis=-4)
+    with pytest.raises(ValueError, match="duplicate value in 'axis'"):
+        func(x, axis=(1, -2))
+    with pytest.raises(TypeError, match="axis must be None, an integer or a tuple"):
+        func(x, axis=1.5)
+
+
+@pytest.mark.parametrize(
+    ("shape", "axis"), [((200, 200), 0), ((200, 10), 0), ((200, 200), 1), ((10, 20, 30), (0, 2))]
+)
+def test_parallel_vectorize_reduce_threads(shape, axis):
+    # Reductions are split along a kept axis, whichever axes are reduced.
+    x = np.ones(shape)
+    assert m.parallel_reduce_threads(x, axis) > 1
+    assert m.parallel_reduce_threads(x, None) == 1
+
+
+def test_vectorize_reduce_custom():
+    x = np.array([[1, 5, 5, 2], [7, 0, 7, 7], [3, 3, 3, 3]], dtype="float64")
+    # The combine step receives the flat index along the reduced axes.
+    assert m.reduce_argmax(x) == 4
+    np.testing.assert_array_equal(m.reduce_argmax(x, axis=1), [1, 0, 0])
+    np.testing.assert_array_equal(m.reduce_argmax(x, axis=0), [1, 0, 1, 1])
+    np.testing.assert_array_equal(m.reduce_argmax(x.T, axis=0), [1, 0, 0])
+    np.testing.assert_array_equal(m.reduce_argmax(x, axis=1, keepdims=True), [[1], [0], [0]])
+    assert m.reduce_argmax(x, axis=1).dtype == np.dtype("intp")
+    assert m.reduce_argmax(x[:, ::-1], axis=(0, 1)) == np.argmax(x[:, ::-1])
+
+    y = np.random.default_rng(0).random((50, 40), dtype="float32")
+    np.testing.assert_allclose(m.reduce_mean(y), y.mean(dtype="float64"))
+    np.testing.assert_allclose(m.reduce_mean(y, axis=0), y.mean(axis=0, dtype="float64"))
+    np.testing.assert_allclose(m.reduce_mean(y, axis=1), y.mean(axis=1, dtype="float64"))
+
+
+def test_vectorize_reduce_any_all():
+    # Boolean accumulators.
+    x = np.array([[0, 0, 1], [0, 2, 3], [0, 0, 0], [4, 5, 6]], dtype="float64")
+    assert m.reduce_any(x)
+    assert not m.parallel_reduce_all(x)
+    for axis in [0, 1, (0, 1), ()]:
+        for keepdims in [False, True]:
+            any_ = m.reduce_any(x, axis=axis, keepdims=keepdims)
+            np.testing.assert_array_equal(any_, np.any(x, axis=axis, keepdims=keepdims))
+            all_ = m.parallel_reduce_all(x, axis=axis, keepdims=keepdims)
+            np.testing.assert_array_equal(all_, np.all(x, axis=axis, keepdims=keepdims))
+    assert m.reduce_any(x, axis=1).dtype == np.bool_
+    y = np.ones((200, 200))
+    y[150, 7] = 0
+    np.testing.assert_array_equal(m.parallel_reduce_all(y, axis=0), np.all(y, axis=0))
+    np.testing.assert_array_equal(m.parallel_reduce_all(y, axis=1), np.all(y, axis=1))
+
+
+def test_ufunc():
+    add = m.ufunc_add
+    assert isinstance(add, np.ufunc)
+    assert add.__name__ == "ufunc_add"
+    assert "Adds two arrays." in add.__doc__
+    assert (add.nin, add.nout, add.identity) == (2, 1, 0)
+    q = np.dtype("int64").char
+    assert add.types == [f"{q}{q}->{q}", "ff->f", "dd->d"]
+
+    # NumPy selects the first loop the arguments can be safely cast to.
+    x = np.arange(6, dtype="float32").reshape(2, 3)
+    assert add(x, x).dtype == np.float32
+    assert add(x, 1.5).dtype == np.float32
+    assert add(x, np.float64(1.5)).dtype == np.float64
+    assert add(np.arange(3), 1).dtype == np.int64
+    assert add(np.arange(3, dtype="int32"), 1).dtype == np.int64
+    assert add(np.arange(3, dtype="uint8"), 1).dtype == np.int64
+    assert add(np.arange(3, dtype="uint64"), 1).dtype == np.float64
+    np.testing.assert_array_equal(add(x, [1, 2, 3]), x + [1, 2, 3])
+    assert add(1, 2) == 3
+
+    # ufunc methods and arguments
+    np.testing.assert_array_equal(add.reduce(x, axis=0), x.sum(axis=0))
+    assert add.reduce(np.arange(10)) == 45
+    assert add.reduce(np.zeros(0)) == 0
+    np.testing.assert_array_equal(add.accumulate(np.arange(5)), np.cumsum(np.arange(5)))
+    np.testing.assert_array_equal(
+        add.outer(np.arange(3), np.arange(4)), np.add.outer(np.arange(3), np.arange(4))
+    )
+    y = np.zeros(4)
+    add.at(y, [0, 0, 2], 1)
+    np.testing.assert_array_equal(y, [2, 0, 1, 0])
+    out = np.full(3, -1.0)
+    assert add([1.0, 2, 3], 1, out=out, where=[True, False, True]) is out
+    np.testing.assert_array_equal(out, [2, -1, 4])
+    assert add(np.arange(3), 1, dtype="float32").dtype == np.float32
+
+    with pytest.raises(TypeError):
+        add(np.array(["a"]), 1)
+
+    # C++ exceptions are translated to Python exceptions
+    sqrt = m.ufunc_checked_sqrt
+    np.testing.assert_array_equal(sqrt(np.array([4.0, 9.0])), [2, 3])
+    with pytest.raises(ValueError, match="negative value: -1"):
+        sqrt(np.array([4.0, -1.0, 9.0]))
+    assert sqrt.identity is None
+
+    with pytest.raises(RuntimeError, match="same number of arguments"):
+        m.ufunc_mismatched_def(m)
@@ -10,9 +10,12 @@
 
 #include "pybind11_tests.h"
 
+#include <cstring>
 #include <memory>
 #include <stdexcept>
+#include <string>
 #include <utility>
+#include <vector>
 
 namespace exercise_trampoline {
 
@@ -187,5 +190,85 @@ TEST_SUBMODULE(pickling, m) {
             }));
 #endif
 
+    // test_roundtrip_buffer
+    class PickleableMatrix {
+    public:
+        PickleableMatrix(ssize_t rows, ssize_t cols)
+            : m_rows(rows), m_cols(cols), m_data(static_cast<size_t>(rows * cols)) {}
+
+        ssize_t rows() const { return m_rows; }
+        ssize_t cols() const { return m_cols; }
+        double *data() { return m_data.data(); }
+        const double *data() const { return m_data.data(); }
+        double &at(ssize_t i, ssize_t j) { return m_data[static_cast<size_t>(i * m_cols + j)]; }
+
+    private:
+        ssize_t m_rows, m_cols;
+        std::vector<double> m_data;
+    };
+
+    py::class_<PickleableMatrix>(m, "PickleableMatrix")
+        .def(py::init<ssize_t, ssize_t>())
+        .def("rows", &PickleableMatrix::rows)
+        .def("cols", &PickleableMatrix::cols)
+        .def("__getitem__",
+             [](PickleableMatrix &mat, std::pair<ssize_t, ssize_t> ij) {
+                 return mat.at(ij.first, ij.second);
+             })
+        .def("__setitem__",
+             [](PickleableMatrix &mat, std::pair<ssize_t, ssize_t> ij, double v) {
+                 mat.at(ij.first, ij.second) = v;
+             })
+        .def("data_address",
+             [](const PickleableMatrix &mat) { return reinterpret_cast<uintptr_t>(mat.data()); })
+        .def(py::pickle(
+            [](const PickleableMatrix &mat) {
+                return py::buffer_info(const_cast<double *>(mat.data()),
+                                       {mat.rows(), mat.cols()},
+                                       {8 * mat.cols(), ssize_t{8}},
+                                       true);
+            },
+            [](const py::buffer_info &info) {
+                if (!info.item_type_is_equivalent_to<double>() || info.ndim != 2) {
+                    throw std::runtime_error("Invalid state!");
+                }
+                PickleableMatrix mat(info.shape[0], info.shape[1]);
+                std::memcpy(mat.data(), info.ptr, static_cast<size_t>(info.size) * 8);
+                return mat;
+            }));
+
+    // Adopts the unpickled buffer instead of copying it.
+    class PickleableBlob {
+    public:
+        explicit PickleableBlob(py::buffer_info &&info) : m_info(std::move(info)) {}
+        explicit PickleableBlob(const std::string &s)
+            : m_owned(s), m_info(const_cast<char *>(m_owned.data()),
+                                 static_cast<ssize_t>(m_owned.size()),
+                                 true) {}
+
+        const py::buffer_info &info() const { return m_info; }
+
+    private:
+        std::string m_owned;
+        py::buffer_info m_info;
+    };
+
+    py::class_<PickleableBlob>(m, "PickleableBlob")
+        .def(py::init<const std::string &>())
+        .def("value",
+             [](const PickleableBlob &b) {
+                 return py::bytes(static_cast<const char *>(b.info().ptr),
+                                  static_cast<size_t>(b.info().size));
+             })
+        .def("data_address",
+             [](const PickleableBlob &b) { return reinterpret_cast<uintptr_t>(b.info().ptr); })
+        .def(py::pickle(
+            [](const PickleableBlob &b) {
+                return py::buffer_info(b.info().ptr, 1, "B", b.info().size, true);
+            },
+            [](py::buffer_info info) {
+                return std::unique_ptr<PickleableBlob>(new PickleableBlob(std::move(info)));
+            }));
+
     exercise_trampoline::wrap(m);
 }
@@ -147,3 +147,52 @@ def test_new_style_pickle_getstate_pos_only():
             )
             is not None
         )
+
+
+@pytest.mark.parametrize("protocol", all_pickle_protocols())
+def test_roundtrip_buffer(protocol):
+    p = m.PickleableMatrix(3, 4)
+    p[1, 2] = 1.5
+    p[2, 3] = -7.25
+    p2 = pickle.loads(pickle.dumps(p, protocol))
+    assert (p2.rows(), p2.cols()) == (3, 4)
+    assert p2[1, 2] == 1.5
+    assert p2[2, 3] == -7.25
+    assert p2[0, 0] == 0.0
+
+
+@pytest.mark.skipif(pickle.HIGHEST_PROTOCOL < 5, reason="requires pickle protocol 5")
+def test_roundtrip_buffer_out_of_band():
+    p = m.PickleableMatrix(1000, 100)
+    p[999, 99] = 42.0
+    buffers = []
+    data = pickle.dumps(p, protocol=5, buffer_callback=buffers.append)
+    assert len(buffers) == 1
+    assert len(data) < 1000  # The payload is not in the pickle stream.
+    with memoryview(buffers[0]) as view:
+        assert view.nbytes == 1000 * 100 * 8
+        assert view.readonly
+    # The out-of-band buffer refers to the original C++ storage and keeps it alive.
+    del p
+    p2 = pickle.loads(data, buffers=buffers)
+    assert (p2.rows(), p2.cols()) == (1000, 100)
+    assert p2[999, 99] == 42.0
+
+
+@pytest.mark.skipif(pickle.HIGHEST_PROTOCOL < 5, reason="requires pickle protocol 5")
+def test_roundtrip_buffer_adopt():
+    b = m.PickleableBlob("abc" * 1000)
+    buffers = []
+    data = pickle.dumps(b, protocol=5, buffer_callback=buffers.append)
+    b2 = pickle.loads(data, buffers=buffers)
+    assert b2.value() == b"abc" * 1000
+    assert b2.data_address() == b.data_address()  # Zero-copy round trip.
+    del b, buffers
+    assert b2.value() == b"abc" * 1000
+
+
+def test_roundtrip_buffer_invalid_state():
+    p = m.PickleableMatrix(2, 2)
+    func, args, state = p.__reduce_ex__(4)
+    with pytest.raises(ValueError, match="does not match its shape"):
+        func(*args).__setstate__((state[0], state[1], state[2], (3, 2)))
@@ -0,0 +1,91 @@
+/*
+    tests/test_polymorphic_downcast.cpp -- RTTI-based downcasting of polymorphic return values
+
+    All rights reserved. Use of this source code is governed by a
+    BSD-style license that can be found in the LICENSE file.
+*/
+
+#include <pybind11/stl.h>
+
+#include "pybind11_tests.h"
+
+#include <memory>
+#include <vector>
+
+namespace pybind11_tests {
+namespace polymorphic_downcast {
+
+// A scene graph: every node is returned to Python as a `Node` pointer, and is downcast to the
+// most-derived registered type.
+struct Node {
+    virtual ~Node() = default;
+    virtual int kind() const = 0;
+};
+
+template <int N>
+struct NodeKind : Node {
+    int kind() const override { return N; }
+};
+
+constexpr int num_node_kinds = 6;
+
+// Derived from a registered type, but not registered itself.
+struct UnregisteredNode : NodeKind<0> {
+    int kind() const override { return -1; }
+};
+
+// Registered and destroyed again by the tests.
+struct TransientNode : Node {
+    int kind() const override { return 100; }
+};
+
+std::unique_ptr<Node> make_node(int kind) {
+    switch (kind) {
+        case 0:
+            return std::unique_ptr<Node>(new NodeKind<0>);
+        case 1:
+            return std::unique_ptr<Node>(new NodeKind<1>);
+        case 2:
+            return std::unique_ptr<Node>(new NodeKind<2>);
+        case 3:
+            return std::unique_ptr<Node>(new NodeKind<3>);
+        case 4:
+            return std::unique_ptr<Node>(new NodeKind<4>);
+        case 5:
+            return std::unique_ptr<Node>(new NodeKind<5>);
+        case 100:
+            return std::unique_ptr<Node>(new TransientNode);
+        default:
+            return std::unique_ptr<Node>(new UnregisteredNode);
+    }
+}
+
+std::vector<std::unique_ptr<Node>> create_scene(int size) {
+    std::vector<std::unique_ptr<Node>> scene;
+    scene.reserve(static_cast<size_t>(size));
+    for (int i = 0; i < size; i++) {
+        scene.push_back(make_node(i % num_node_kinds));
+    }
+    return scene;
+}
+
+} // namespace polymorphic_downcast
+} // namespace pybind11_tests
+
+TEST_SUBMODULE(polymorphic_downcast, m) {
+    using namespace pybind11_tests::polymorphic_downcast;
+
+    py::class_<Node>(m, "Node").def("kind", &Node::kind);
+    py::class_<NodeKind<0>, Node>(m, "Node0");
+    py::class_<NodeKind<1>, Node>(m, "Node1");
+    py::class_<NodeKind<2>, Node>(m, "Node2");
+    py::class_<NodeKind<3>, Node>(m, "Node3");
+    py::class_<NodeKind<4>, Node>(m, "Node4");
+    py::class_<NodeKind<5>, Node>(m, "Node5");
+    m.attr("num_node_kinds") = num_node_kinds;
+
+    m.def("make_node", &make_node);
+    m.def("create_scene", &create_scene);
+    m.def("register_transient_node",
+          [](const py::object &scope) { py::class_<TransientNode, Node>(scope, "TransientNode"); });
+}
@@ -0,0 +1,50 @@
+from __future__ import annotations
+
+import gc
+
+import pytest
+
+import env
+from pybind11_tests import polymorphic_downcast as m
+
+
+def test_downcast():
+    assert [type(m.make_node(kind)) for kind in range(m.num_node_kinds)] == [
+        m.Node0,
+        m.Node1,
+        m.Node2,
+        m.Node3,
+        m.Node4,
+        m.Node5,
+    ]
+    # Not registered: falls back to the static type.
+    node = m.make_node(-1)
+    assert type(node) is m.Node
+    assert node.kind() == -1
+
+
+def test_scene():
+    # Exercises the per-dynamic-type cache (use `pytest --durations` to time it).
+    scene = m.create_scene(60000)
+    assert len(scene) == 60000
+    for i in range(m.num_node_kinds):
+        nodes = scene[i :: m.num_node_kinds]
+        assert all(type(node) is type(nodes[0]) for node in nodes)
+        assert nodes[0].kind() == i
+    assert len({type(node) for node in scene}) == m.num_node_kinds
+
+
+@pytest.mark.skipif("env.PYPY or env.GRAALPY", reason="Relies on prompt type destruction")
+def test_transient_type():
+    class Scope:
+        pass
+
+    assert type(m.make_node(100)) is m.Node
+    m.register_transient_node(Scope)
+    assert type(m.make_node(100)) is Scope.TransientNode
+    del Scope.TransientNode
+    gc.collect()
+    # The type is gone: the cached lookup must not be used anymore.
+    assert type(m.make_node(100)) is m.Node
+    m.register_transient_node(Scope)
+    assert type(m.make_node(100)) is Scope.TransientNode
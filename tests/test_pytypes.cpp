@@ -207,6 +207,21 @@ TEST_SUBMODULE(pytypes, m) {
     m.def("get_list_from_iterable", [](const py::iterable &iter) { return py::list(iter); });
     m.def("get_set_from_iterable", [](const py::iterable &iter) { return py::set(iter); });
     m.def("get_tuple_from_iterable", [](const py::iterable &iter) { return py::tuple(iter); });
+    // test_iterable_view
+    m.def("sum_iterable_view", [](const py::iterable_view<int> &values) {
+        long long total = 0;
+        for (int value : values) {
+            total += value;
+        }
+        return total;
+    });
+    m.def("take_from_iterable_view", [](const py::iterable_view<std::string> &values, int n) {
+        py::list result;
+        for (auto it = values.begin(); n > 0 && it != values.end(); ++it, --n) {
+            result.append(*it);
+        }
+        return result;
+    });
     // test_float
     m.def("get_float", [] { return py::float_(0.0f); });
     m.def("float_roundtrip", [](py::float_ f) { return f; });
@@ -723,6 +738,31 @@ TEST_SUBMODULE(pytypes, m) {
         return py::memoryview::from_memory(buf, static_cast<py::ssize_t>(strlen(buf)));
     });
 
+    // test_owned_memoryview
+    static std::uintptr_t owned_memoryview_data = 0;
+    m.def("owned_memoryview_from_string", [](std::size_t size) {
+        std::string value(size, 'x');
+        owned_memoryview_data = reinterpret_cast<std::uintptr_t>(value.data());
+        return py::owned_memoryview(std::move(value));
+    });
+    m.def("owned_memoryview_from_vector", [](std::size_t size) {
+        std::vector<std::uint8_t> value(size);
+        for (std::size_t i = 0; i < size; ++i) {
+            value[i] = static_cast<std::uint8_t>(i);
+        }
+        owned_memoryview_data = reinterpret_cast<std::uintptr_t>(value.data());
+        return py::owned_memoryview(std::move(value));
+    });
+    m.def("owned_memoryview_from_array", []() {
+        std::unique_ptr<std::uint8_t[]> value(new std::uint8_t[3]{1, 2, 3});
+        owned_memoryview_data = reinterpret_cast<std::uintptr_t>(value.get());
+        return py::owned_memoryview(std::move(value), 3);
+    });
+    m.def("owned_memoryview_data", []() { return owned_memoryview_data; });
+    m.def("buffer_data", [](const py::buffer &b) {
+        return reinterpret_cast<std::uintptr_t>(b.request().ptr);
+    });
+
     // test_builtin_functions
     m.def("get_len", [](py::handle h) { return py::len(h); });
 
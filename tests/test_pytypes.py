@@ -3,6 +3,7 @@ from __future__ import annotations
 import contextlib
 import sys
 import types
+import weakref
 
 import pytest
 
@@ -59,6 +60,42 @@ def test_iterable(doc):
     assert i == 2
 
 
+def test_iterable_view(doc):
+    assert (
+        doc(m.sum_iterable_view)
+        == "sum_iterable_view(arg0: collections.abc.Iterable[typing.SupportsInt]) -> int"
+    )
+    assert m.sum_iterable_view([]) == 0
+    assert m.sum_iterable_view([1, 2, 3]) == 6
+    assert m.sum_iterable_view(range(100000)) == 4999950000
+    assert m.sum_iterable_view(i for i in range(10)) == 45
+
+    # Items are pulled one at a time.
+    pulled = []
+
+    def numbers():
+        for i in range(100):
+            pulled.append(i)
+            yield str(i)
+
+    gen = numbers()
+    assert m.take_from_iterable_view(gen, 3) == ["0", "1", "2"]
+    assert pulled == [0, 1, 2]
+    assert m.take_from_iterable_view(gen, 2) == ["3", "4"]
+
+    with pytest.raises(TypeError):
+        m.sum_iterable_view(1)
+    with pytest.raises(RuntimeError, match="Unable to cast"):
+        m.sum_iterable_view([1, "2"])
+
+    def failing():
+        yield 1
+        raise ValueError("generator failed")
+
+    with pytest.raises(ValueError, match="generator failed"):
+        m.sum_iterable_view(failing())
+
+
 def test_float(doc):
     assert doc(m.get_float) == "get_float() -> float"
     assert doc(m.float_roundtrip) == "float_roundtrip(arg0: float) -> float"
@@ -682,6 +719,35 @@ def test_memoryview_from_memory():
     assert bytes(view) == b"\xff\xe1\xab\x37"
 
 
+def test_owned_memoryview():
+    view = m.owned_memoryview_from_string(1 << 20)
+    assert isinstance(view, memoryview)
+    assert view.readonly
+    assert view.format == "B"
+    assert view.nbytes == 1 << 20
+    assert bytes(view[:3]) == b"xxx"
+    # Not copied: the memoryview points into the moved C++ string.
+    assert m.buffer_data(view) == m.owned_memoryview_data()
+
+    view = m.owned_memoryview_from_vector(5)
+    assert m.buffer_data(view) == m.owned_memoryview_data()
+    assert view.tolist() == [0, 1, 2, 3, 4]
+    with pytest.raises(TypeError):
+        view[0] = 1
+    assert bytes(m.owned_memoryview_from_vector(0)) == b""
+
+    view = m.owned_memoryview_from_array()
+    assert m.buffer_data(view) == m.owned_memoryview_data()
+    assert bytes(view) == b"\x01\x02\x03"
+
+    # The storage is freed together with the memoryview.
+    owner = weakref.ref(view.obj)
+    view.release()
+    del view
+    pytest.gc_collect()
+    assert owner() is None
+
+
 def test_builtin_functions():
     assert m.get_len(list(range(42))) == 42
     with pytest.raises(TypeError) as exc_info:
@@ -231,6 +231,16 @@ TEST_SUBMODULE(stl, m) {
     m.def("load_map", [](const std::map<std::string, std::string> &map) {
         return map.at("key") == "value" && map.at("key2") == "value2";
     });
+    m.def("cast_map_of_size", [](int size) {
+        std::map<int, double> map;
+        for (int i = 0; i < size; ++i) {
+            map[i] = i * 0.5;
+        }
+        return map;
+    });
+    m.def("cast_map_invalid_utf8_value", []() {
+        return std::map<int, std::string>{{1, "ok"}, {2, std::string("\xff")}};
+    });
 
     // test_set
     m.def("cast_set", []() { return std::set<std::string>{"key1", "key2"}; });
@@ -546,6 +556,26 @@ TEST_SUBMODULE(stl, m) {
         using V = variant<std::monostate, int, std::string>;
         return py::make_tuple(V{}, V(5), V("Hello"));
     });
+
+    // test_variant_alternative_filter
+    struct VariantFromStr {
+        std::string value;
+    };
+    py::class_<VariantFromStr>(m, "VariantFromStr")
+        .def(py::init<std::string>())
+        .def_readonly("value", &VariantFromStr::value);
+    py::implicitly_convertible<py::str, VariantFromStr>();
+    m.def("load_variant_index",
+          [](const variant<std::int16_t, std::int64_t, double, UserType, std::vector<double>> &v) {
+              return v.index();
+          });
+    m.def("load_variant_implicit",
+          [](const variant<std::monostate, int, VariantFromStr> &v) -> py::object {
+              if (v.index() == 2) {
+                  return py::str(std::get<2>(v).value);
+              }
+              return py::int_(v.index());
+          });
 #    endif
 #endif
 
@@ -664,4 +694,44 @@ TEST_SUBMODULE(stl, m) {
         "roundtrip_std_set_int_noconvert",
         [](const std::set<int> &s) { return s; },
         py::arg("s").noconvert());
+
+    // test_vector_from_buffer
+    m.def("roundtrip_std_vector_double", [](const std::vector<double> &v) { return v; });
+    m.def(
+        "roundtrip_std_vector_double_noconvert",
+        [](const std::vector<double> &v) { return v; },
+        py::arg("v").noconvert());
+    m.def("roundtrip_std_vector_uint16", [](const std::vector<std::uint16_t> &v) { return v; });
+    m.def("roundtrip_std_deque_int", [](const std::deque<int> &v) { return v; });
+
+#if defined(PYBIND11_HAS_SPAN)
+    // test_span
+    m.def("sum_span", [](std::span<const double> s) {
+        double sum = 0;
+        for (double v : s) {
+            sum += v;
+        }
+        return sum;
+    });
+    m.def("scale_span", [](std::span<float> s, float factor) {
+        for (float &v : s) {
+            v *= factor;
+        }
+    });
+    m.def("sum_span_bytes", [](std::span<const std::uint8_t> s) {
+        int sum = 0;
+        for (auto v : s) {
+            sum += v;
+        }
+        return sum;
+    });
+    m.def("span_of_3", [](std::span<const int, 3> s) { return s[0] * 100 + s[1] * 10 + s[2]; });
+    m.def("span_data_address", [](std::span<const double> s) {
+        return reinterpret_cast<std::uintptr_t>(s.data());
+    });
+    m.def("return_span", []() {
+        static const int values[] = {1, 2, 3};
+        return std::span<const int>(values);
+    });
+#endif
 }
@@ -1,5 +1,7 @@
 from __future__ import annotations
 
+import ctypes
+
 import pytest
 
 import env  # noqa: F401
@@ -85,6 +87,13 @@ def test_map(doc):
     assert "key2" in d
     assert m.load_map(d)
 
+    for size in (0, 1, 5, 6, 1000):
+        d = m.cast_map_of_size(size)
+        assert d == {i: i * 0.5 for i in range(size)}
+        assert list(d) == list(range(size))
+    with pytest.raises(UnicodeDecodeError):
+        m.cast_map_invalid_utf8_value()
+
     assert doc(m.cast_map) == "cast_map() -> dict[str, str]"
     assert (
         doc(m.load_map) == "load_map(arg0: collections.abc.Mapping[str, str]) -> bool"
@@ -372,6 +381,47 @@ def test_variant_monostate(doc):
     )
 
 
+@pytest.mark.skipif(
+    not hasattr(m, "load_variant_index"), reason="no std::variant<std::monostate, ...>"
+)
+def test_variant_alternative_filter():
+    from pybind11_tests import UserType
+
+    class Index:
+        def __index__(self):
+            return 7
+
+    class FloatOnly:
+        def __float__(self):
+            return 0.5
+
+    load = m.load_variant_index
+    assert load(5) == 0
+    assert load(True) == 0
+    assert load(Index()) == 0
+    assert load(2**20) == 1
+    assert load(-(2**40)) == 1
+    assert load(2**70) == 2
+    assert load(1.5) == 2
+    assert load(FloatOnly()) == 2
+    assert load(UserType(1)) == 3
+    assert load([1.5, 2.5]) == 4
+    assert load((1, 2.5)) == 4
+    with pytest.raises(TypeError):
+        load("1")
+    with pytest.raises(TypeError):
+        load(None)
+    with pytest.raises(TypeError):
+        load({1: 2})
+
+    # Bound classes can still be reached through implicit conversions from builtins.
+    assert m.load_variant_implicit(None) == 0
+    assert m.load_variant_implicit(3) == 1
+    assert m.load_variant_implicit("abc") == "abc"
+    with pytest.raises(TypeError):
+        m.load_variant_implicit(b"abc")
+
+
 def test_vec_of_reference_wrapper():
     """#171: Can't return reference wrappers (or STL structures containing them)"""
     assert (
@@ -642,6 +692,121 @@ def test_sequence_caster_protocol(doc):
     assert m.roundtrip_std_vector_int_noconvert(BareSequenceLike()) == []
 
 
+def test_vector_from_buffer():
+    from array import array
+
+    # Same item kind and size: copied in both modes.
+    assert m.roundtrip_std_vector_double(array("d", [1.5, 2.5])) == [1.5, 2.5]
+    assert m.roundtrip_std_vector_double_noconvert(array("d", [1.5, 2.5])) == [1.5, 2.5]
+    assert m.roundtrip_std_vector_int(array("i", [1, 2, 3])) == [1, 2, 3]
+    assert m.roundtrip_std_vector_int_noconvert(array("i", [1, 2, 3])) == [1, 2, 3]
+    assert m.roundtrip_std_vector_int(array("i")) == []
+    assert m.roundtrip_std_vector_uint16(bytearray(b"\x01\xff")) == [1, 255]
+    assert m.roundtrip_std_vector_uint16(memoryview(b"\x01\xff")) == [1, 255]
+    with pytest.raises(TypeError):
+        m.roundtrip_std_vector_uint16(b"\x01\xff")  # Still rejected (bytes-like).
+    # Strided.
+    assert m.roundtrip_std_vector_int(memoryview(array("i", range(10)))[::3]) == [
+        0,
+        3,
+        6,
+        9,
+    ]
+    assert m.roundtrip_std_vector_double(memoryview(array("d", [1, 2, 3]))[::-1]) == [
+        3.0,
+        2.0,
+        1.0,
+    ]
+    # Converted, following the rules of the scalar casters.
+    assert m.roundtrip_std_vector_double(array("f", [0.5])) == [0.5]
+    assert m.roundtrip_std_vector_double(array("q", [-(2**40)])) == [-(2.0**40)]
+    assert m.roundtrip_std_vector_int(array("q", [-5, 7])) == [-5, 7]
+    assert m.roundtrip_std_vector_uint16(array("I", [65535])) == [65535]
+    with pytest.raises(TypeError):
+        m.roundtrip_std_vector_int(array("q", [2**40]))
+    with pytest.raises(TypeError):
+        m.roundtrip_std_vector_uint16(array("I", [65536]))
+    with pytest.raises(TypeError):
+        m.roundtrip_std_vector_uint16(array("b", [-1]))
+    with pytest.raises(TypeError):
+        m.roundtrip_std_vector_int(array("d", [1.0]))
+    with pytest.raises(TypeError):
+        m.roundtrip_std_vector_double_noconvert(array("i", [1]))
+    # Not a std::vector: generic path.
+    assert m.roundtrip_std_deque_int(array("i", [1, 2])) == [1, 2]
+
+
+def test_vector_from_list_of_numbers():
+    assert m.roundtrip_std_vector_double([1.5, -2.5, 1e300]) == [1.5, -2.5, 1e300]
+    assert m.roundtrip_std_vector_double((1.5, 2)) == [1.5, 2.0]
+    assert m.roundtrip_std_vector_double_noconvert([1.5, 2.5]) == [1.5, 2.5]
+    with pytest.raises(TypeError):
+        m.roundtrip_std_vector_double_noconvert([1.5, 2])
+    assert m.roundtrip_std_vector_int([1, -2, 2**31 - 1, -(2**31)]) == [
+        1,
+        -2,
+        2**31 - 1,
+        -(2**31),
+    ]
+    assert m.roundtrip_std_vector_int_noconvert((3, 4)) == [3, 4]
+    assert m.roundtrip_std_deque_int([5, 6]) == [5, 6]
+    assert m.roundtrip_std_vector_uint16([0, 65535]) == [0, 65535]
+    for out_of_range in (2**31, 2**40, 2**100):
+        with pytest.raises(TypeError):
+            m.roundtrip_std_vector_int([1, out_of_range])
+    with pytest.raises(TypeError):
+        m.roundtrip_std_vector_uint16([-1])
+    with pytest.raises(TypeError):
+        m.roundtrip_std_vector_int([1, 2.0])
+
+    # Items that are not exact `int` or `float` objects go through the scalar casters.
+    class MyInt(int):
+        pass
+
+    class MyFloat(float):
+        pass
+
+    assert m.roundtrip_std_vector_int([1, MyInt(2), True]) == [1, 2, 1]
+    assert m.roundtrip_std_vector_double([MyFloat(0.5), 1.5]) == [0.5, 1.5]
+
+    # List subclasses take the generic sequence path.
+    class ReversedList(list):
+        def __iter__(self):
+            return reversed(self[:])
+
+    assert m.roundtrip_std_vector_int(ReversedList([1, 2, 3])) == [3, 2, 1]
+
+    # The list may be modified while an item is converted.
+    items = []
+
+    class Shrinking:
+        def __index__(self):
+            items.clear()
+            return 7
+
+    items.extend([Shrinking(), 2, 3])
+    assert m.roundtrip_std_vector_int(items) == [7]
+
+
+def test_vector_from_numpy_array():
+    np = pytest.importorskip("numpy")
+
+    values = np.arange(10, dtype=np.float64)
+    assert m.roundtrip_std_vector_double(values) == values.tolist()
+    assert m.roundtrip_std_vector_double_noconvert(values[::2]) == values[::2].tolist()
+    assert m.roundtrip_std_vector_double(values.astype(np.float32)) == values.tolist()
+    assert m.roundtrip_std_vector_double(values.astype(np.uint16)) == values.tolist()
+    assert m.roundtrip_std_vector_int(values.astype(np.int64)) == values.tolist()
+    assert m.roundtrip_std_vector_int_noconvert(values.astype(np.intc)) == values.tolist()
+    with pytest.raises(TypeError):
+        m.roundtrip_std_vector_double_noconvert(values.astype(np.float32))
+    with pytest.raises(TypeError):
+        m.roundtrip_std_vector_int(values)
+    # Multi-dimensional arrays go through the generic path, element by element.
+    with pytest.raises(TypeError):
+        m.roundtrip_std_vector_double(values.reshape(2, 5))
+
+
 def test_mapping_caster_protocol(doc):
     from collections.abc import Mapping
 
@@ -733,3 +898,41 @@ def test_set_caster_protocol(doc):
         m.roundtrip_std_set_int_noconvert(FormalSetLike(1, 2, 3))
     with pytest.raises(TypeError):
         m.roundtrip_std_set_int_noconvert(BareSetLike(1, 2, 3))
+
+
+@pytest.mark.skipif(not hasattr(m, "sum_span"), reason="no <span>")
+def test_span():
+    from array import array
+
+    assert m.sum_span(array("d", [1.5, 2.5])) == 4.0
+    assert m.sum_span(memoryview(array("d"))) == 0.0
+    # Zero-copy: the span points into the buffer of the argument.
+    data = array("d", [1.0])
+    assert m.span_data_address(data) == data.buffer_info()[0]
+    values = array("f", [1, 2, 3])
+    m.scale_span(values, 2)
+    assert values.tolist() == [2, 4, 6]
+    assert m.sum_span_bytes(b"\x01\x02") == 3
+    assert m.sum_span_bytes(bytearray(b"\xff")) == 255
+    assert m.span_of_3(array("i", [1, 2, 3])) == 123
+    assert m.return_span() == [1, 2, 3]
+
+    # No implicit conversions: item type, layout, writability and extent must match.
+    with pytest.raises(TypeError):
+        m.sum_span([1.0, 2.0])
+    with pytest.raises(TypeError):
+        m.sum_span(array("f", [1.0]))
+    with pytest.raises(TypeError):
+        m.sum_span(memoryview(array("d", [1, 2, 3]))[::2])
+    with pytest.raises(TypeError):
+        m.scale_span(memoryview(array("f", [1])).toreadonly(), 2)
+    with pytest.raises(TypeError):
+        m.span_of_3(array("i", [1, 2]))
+    # Misaligned items, e.g. `np.frombuffer(b, dtype="f8", offset=1)`, cannot be viewed.
+    raw = bytearray(24)
+    align = ctypes.alignment(ctypes.c_double)
+    aligned = -ctypes.addressof(ctypes.c_char.from_buffer(raw)) % align
+    assert m.sum_span(memoryview(raw)[aligned : aligned + 8].cast("d")) == 0.0
+    with pytest.raises(TypeError):
+        m.sum_span(memoryview(raw)[aligned + 1 : aligned + 9].cast("d"))
+    assert m.sum_span.__doc__.startswith("sum_span(arg0: collections.abc.Buffer) -> float")
@@ -71,6 +71,18 @@ NestMap *times_hundred(int n) {
     return m;
 }
 
+struct ReadonlyViewItem {
+    int value;
+};
+
+struct ReadonlyViewOwner {
+    std::vector<int> numbers{1, 2, 3, 2};
+    std::vector<ReadonlyViewItem> items{{10}, {20}};
+    std::vector<bool> flags{true, false};
+    std::map<std::string, double> weights{{"a", 0.5}, {"b", 1.5}};
+    std::map<double, ReadonlyViewItem> items_by_key{{1.0, {100}}};
+};
+
 /*
  * Recursive data structures as test for issue #4623
  */
@@ -253,6 +265,44 @@ TEST_SUBMODULE(stl_binders, m) {
     py::bind_vector<UserVectorLike>(m, "UserVectorLike");
     py::bind_map<UserMapLike>(m, "UserMapLike");
 
+    // test_readonly_view
+    py::class_<ReadonlyViewItem>(m, "ReadonlyViewItem")
+        .def_readonly("value", &ReadonlyViewItem::value);
+    py::class_<ReadonlyViewOwner>(m, "ReadonlyViewOwner")
+        .def(py::init<>())
+        .def_property_readonly("numbers",
+                               [](py::handle self) {
+                                   return py::readonly_view(
+                                       self.cast<const ReadonlyViewOwner &>().numbers, self);
+                               })
+        .def_property_readonly("items",
+                               [](py::handle self) {
+                                   return py::readonly_view(
+                                       self.cast<const ReadonlyViewOwner &>().items, self);
+                               })
+        .def_property_readonly("flags",
+                               [](py::handle self) {
+                                   return py::readonly_view(
+                                       self.cast<const ReadonlyViewOwner &>().flags, self);
+                               })
+        .def_property_readonly("weights",
+                               [](py::handle self) {
+                                   return py::readonly_view(
+                                       self.cast<const ReadonlyViewOwner &>().weights, self);
+                               })
+        .def_property_readonly("items_by_key",
+                               [](py::handle self) {
+                                   return py::readonly_view(
+                                       self.cast<const ReadonlyViewOwner &>().items_by_key, self);
+                               })
+        .def("append_number", [](ReadonlyViewOwner &o, int n) { o.numbers.push_back(n); })
+        .def("set_item_value",
+             [](ReadonlyViewOwner &o, size_t i, int value) { o.items.at(i).value = value; });
+    m.def("readonly_view_of_static", []() {
+        static const std::vector<int> numbers{4, 5};
+        return py::readonly_view(numbers, py::none());
+    });
+
     // The rest depends on numpy:
     try {
         py::module_::import("numpy");
@@ -1,5 +1,7 @@
 from __future__ import annotations
 
+import weakref
+
 import pytest
 
 from pybind11_tests import stl_binders as m
@@ -412,3 +414,110 @@ def test_user_like_map():
     map[33] = 44
     assert map[33] == 44
     assert len(map) == 1
+
+
+def test_readonly_view_sequence():
+    from collections.abc import Sequence
+
+    owner = m.ReadonlyViewOwner()
+    numbers = owner.numbers
+    assert isinstance(numbers, Sequence)
+    assert not isinstance(numbers, list)
+    assert len(numbers) == 4
+    assert numbers[0] == 1
+    assert numbers[-1] == 2
+    assert numbers[1:3] == [2, 3]
+    assert numbers[::-2] == [2, 2]
+    assert list(numbers) == [1, 2, 3, 2]
+    assert list(reversed(numbers)) == [2, 3, 2, 1]
+    assert 3 in numbers
+    assert 4 not in numbers
+    assert "3" not in numbers
+    assert numbers.count(2) == 2
+    assert numbers.index(3) == 2
+    with pytest.raises(ValueError):
+        numbers.index(4)
+    with pytest.raises(IndexError):
+        numbers[4]
+    with pytest.raises(IndexError):
+        numbers[-5]
+    with pytest.raises(TypeError):
+        numbers[0] = 5
+
+    # The view refers to the C++ container, it is not a copy.
+    owner.append_number(7)
+    assert len(numbers) == 5
+    assert numbers[4] == 7
+
+    assert list(owner.flags) == [True, False]
+    assert owner.flags[1] is False
+
+
+def test_readonly_view_items_are_references():
+    owner = m.ReadonlyViewOwner()
+    items = owner.items
+    first = items[0]
+    assert first.value == 10
+    owner.set_item_value(0, 11)
+    assert first.value == 11
+    assert [item.value for item in items] == [11, 20]
+    assert [item.value for item in items[1:]] == [20]
+
+
+def test_readonly_view_keeps_owner_alive():
+    owner = m.ReadonlyViewOwner()
+    owner_ref = weakref.ref(owner)
+    numbers = owner.numbers
+    items = owner.items
+    weights = owner.weights
+    del owner
+    pytest.gc_collect()
+    assert owner_ref() is not None
+    assert numbers[3] == 2
+    assert items[1].value == 20
+    assert weights["b"] == 1.5
+
+    # An item returned by reference keeps the view, and so the owner, alive.
+    item = items[0]
+    del numbers, items, weights
+    pytest.gc_collect()
+    assert owner_ref() is not None
+    assert item.value == 10
+    del item
+    pytest.gc_collect()
+    assert owner_ref() is None
+
+    assert list(m.readonly_view_of_static()) == [4, 5]
+
+
+def test_readonly_view_mapping():
+    from collections.abc import Mapping
+
+    owner = m.ReadonlyViewOwner()
+    weights = owner.weights
+    assert isinstance(weights, Mapping)
+    assert not isinstance(weights, dict)
+    assert len(weights) == 2
+    assert weights["a"] == 0.5
+    assert list(weights) == ["a", "b"]
+    assert "b" in weights
+    assert "c" not in weights
+    assert 1 not in weights
+    with pytest.raises(KeyError):
+        weights["c"]
+    with pytest.raises(KeyError):
+        weights[1]
+    assert weights.get("b") == 1.5
+    assert weights.get("c") is None
+    assert weights.get("c", 2.5) == 2.5
+    assert list(weights.keys()) == ["a", "b"]
+    assert list(weights.values()) == [0.5, 1.5]
+    assert list(weights.items()) == [("a", 0.5), ("b", 1.5)]
+    assert "a" in weights.keys()
+    assert dict(weights) == {"a": 0.5, "b": 1.5}
+
+    # Keys are converted like function arguments (here: int -> double).
+    items_by_key = owner.items_by_key
+    assert items_by_key[1].value == 100
+    assert 1 in items_by_key
+    assert items_by_key.get(2.0) is None